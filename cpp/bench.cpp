@@ -30,6 +30,7 @@
 #include <csignal>
 #include <cstdio>
 #include <iostream>  // `std::cerr`
+#include <mutex>     // `std::mutex`
 #include <numeric>   // `std::iota`
 #include <stdexcept> // `std::invalid_argument`
 #include <string>    // `std::to_string`
@@ -278,26 +279,39 @@ struct running_stats_printer_t {
     }
 };
 
+template <typename real_at> struct strided_vectors_gt {
+    real_at const* data;
+    std::size_t dims;
+    vector_view_t operator[](std::size_t i) const noexcept { return {data + dims * i, dims}; }
+};
+
+template <typename index_at, typename vector_id_at, typename real_at, typename progress_at>
+void add_many(index_at& native, std::size_t n, vector_id_at const* ids, real_at const* vectors, std::size_t dims,
+              add_config_t config, progress_at&& progress) {
+    executor_default_t executor(native.limits().threads());
+    native.add_many(ids, strided_vectors_gt<real_at>{vectors, dims}, n, config, executor, progress).error.raise();
+}
+
+template <typename label_at, typename id_at, typename vector_id_at, typename real_at, typename progress_at>
+void add_many(index_punned_dense_gt<label_at, id_at>& native, std::size_t n, vector_id_at const* ids,
+              real_at const* vectors, std::size_t dims, add_config_t config, progress_at&& progress) {
+    executor_default_t executor(native.limits().threads());
+    native.add_many(ids, vectors, n, dims * sizeof(real_at), config, executor, progress).error.raise();
+}
+
 template <typename index_at, typename vector_id_at, typename real_at>
 void index_many(index_at& native, std::size_t n, vector_id_at const* ids, real_at const* vectors, std::size_t dims) {
 
     running_stats_printer_t printer{n, "Indexing"};
-
-#if USEARCH_USE_OPENMP
-#pragma omp parallel for schedule(static, 32)
-#endif
-    for (std::size_t i = 0; i < n; ++i) {
-        add_config_t config;
-#if USEARCH_USE_OPENMP
-        config.thread = omp_get_thread_num();
-#endif
-        config.store_vector = true;
-        vector_view_t vector{vectors + dims * i, dims};
-        native.add(ids[i], vector, config);
-        printer.progress++;
-        if (config.thread == 0)
+    std::mutex printer_mutex;
+    add_config_t config;
+    config.store_vector = true;
+    add_many(native, n, ids, vectors, dims, config, [&](std::size_t passed, std::size_t) {
+        printer.progress = passed;
+        std::unique_lock<std::mutex> lock(printer_mutex, std::try_to_lock);
+        if (lock)
             printer.refresh();
-    }
+    });
 }
 
 template <typename index_at, typename vector_id_at, typename real_at>
@@ -2,9 +2,17 @@
  * @brief A trivial test.
  */
 #include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <mutex>
+#include <random>
 #include <stdexcept>
+#include <thread>
+#include <vector>
 
+#include <usearch/index_punned_auto.hpp>
 #include <usearch/index_punned_dense.hpp>
+#include <usearch/index_sharded.hpp>
 
 using namespace unum::usearch;
 using namespace unum;
@@ -14,6 +22,68 @@ void expect(bool must_be_true) {
         throw std::runtime_error("Failed!");
 }
 
+/**
+ *  Normally distributed vectors, shared by the tests of larger indexes.
+ *  The same ::seed always produces the same dataset.
+ */
+std::vector<float> random_vectors(std::size_t count, std::size_t dimensions, unsigned seed) {
+    std::vector<float> vectors(count * dimensions);
+    std::mt19937 generator(seed);
+    std::normal_distribution<float> distribution;
+    for (float& scalar : vectors)
+        scalar = distribution(generator);
+    return vectors;
+}
+
+/**
+ *  Counts the ::vectors, which closest match in the ::index is their own label,
+ *  assigned as `label_of(i)` to the i-th vector.
+ */
+template <typename index_at, typename label_of_at>
+std::size_t count_self_matches(index_at const& index, std::vector<float> const& vectors, std::size_t dimensions,
+                               label_of_at&& label_of) {
+    std::size_t found = 0;
+    for (std::size_t i = 0; i != vectors.size() / dimensions; ++i)
+        found += index.search(vectors.data() + i * dimensions, 1)[0].member.label == label_of(i);
+    return found;
+}
+
+/**
+ *  Checks, that most of the ::vectors find their own labels in the ::index.
+ */
+template <typename index_at, typename label_of_at>
+void expect_self_matches(index_at const& index, std::vector<float> const& vectors, std::size_t dimensions,
+                         label_of_at&& label_of) {
+    std::size_t count = vectors.size() / dimensions;
+    expect(count_self_matches(index, vectors, dimensions, label_of) > count * 9 / 10);
+}
+
+/**
+ *  Exports the labels of the closest matches, regardless of the kind of results, the ::index returns.
+ */
+template <typename index_at>
+std::size_t search_labels(index_at const& index, float const* query, std::size_t wanted, std::uint64_t* labels) {
+    return index.search(query, wanted).dump_to(labels);
+}
+std::size_t search_labels(punned_auto_t const& index, float const* query, std::size_t wanted, std::uint64_t* labels) {
+    return index.search(query, wanted, labels);
+}
+
+/**
+ *  Checks, that both indexes return the same labels for a sample of the ::vectors,
+ *  like an index and its copy, or the one loaded from its file.
+ */
+template <typename first_at, typename second_at>
+void expect_same_matches(first_at const& first, second_at const& second, std::vector<float> const& vectors,
+                         std::size_t dimensions) {
+    std::uint64_t expected[10], found[10];
+    for (std::size_t i = 0; i < vectors.size() / dimensions; i += 5) {
+        std::size_t expected_count = search_labels(first, vectors.data() + i * dimensions, 10, expected);
+        expect(search_labels(second, vectors.data() + i * dimensions, 10, found) == expected_count);
+        expect(std::equal(expected, expected + expected_count, found));
+    }
+}
+
 template <typename scalar_at, typename index_at> void test3d(index_at&& index) {
 
     using scalar_t = scalar_at;
@@ -84,6 +154,8 @@ template <typename scalar_at, typename index_at> void test3d_punned(index_at&& i
     using scalar_t = scalar_at;
     using view_t = span_gt<scalar_t const>;
     using span_t = span_gt<scalar_at>;
+    using index_t = typename std::remove_reference<index_at>::type;
+    using search_result_t = typename index_t::search_result_t;
 
     scalar_t vec42[3] = {10, 20, 15};
     scalar_t vec43[3] = {19, 22, 11};
@@ -100,10 +172,1067 @@ template <typename scalar_at, typename index_at> void test3d_punned(index_at&& i
 
     index.add(43, view_t{&vec43[0], 3ul});
     expect(index.size() == 2);
+
+    // Interleaved batch search
+    scalar_t queries[6] = {10, 20, 15, 19, 22, 11};
+    std::size_t batch_matches = 0;
+    auto check_batch = [&](std::size_t query_idx, search_result_t const& result) {
+        batch_matches += result.size() == 1 && result[0].member.label == 42 + query_idx;
+    };
+    expect(bool(index.search_batch(&queries[0], 2, 3 * sizeof(scalar_t), 1, check_batch)));
+    expect(batch_matches == 2);
+
+    // Radius search
+    search_result_t in_range = index.search_range(&vec42[0], 0.01f);
+    expect(in_range.size() == 1);
+    expect(in_range[0].member.label == 42);
+    expect(index.search_range(&vec42[0], 1e6f).size() == 2);
+
     index.remove(43);
     expect(index.size() == 1);
 }
 
+template <typename index_at> void test_rerank(index_at&& index) {
+
+    using index_t = typename std::remove_reference<index_at>::type;
+    using search_result_t = typename index_t::search_result_t;
+
+    // Both vectors share the same 8-bit representation
+    float vec42[3] = {0.1f, 0.2f, 0.3f};
+    float vec43[3] = {0.1f, 0.2f, 0.301f};
+
+    expect(index.enable_rerank());
+    index.reserve(10);
+    index.add(42, &vec42[0]);
+    index.add(43, &vec43[0]);
+
+    auto check = [&] {
+        search_result_t result = index.search(&vec43[0], 1);
+        expect(result.size() == 1);
+        expect(result[0].member.label == 43);
+        expect(result[0].distance < 1e-5f);
+        float reconstructed[3] = {0, 0, 0};
+        index.get(43, &reconstructed[0]);
+        expect(reconstructed[2] == vec43[2]);
+    };
+    check();
+
+    // The full-precision vectors are appended to the serialized index
+    index.save("tmp.usearch");
+    index.load("tmp.usearch");
+    expect(index.rerank_enabled());
+    check();
+    index.view("tmp.usearch");
+    expect(index.rerank_enabled());
+    check();
+
+    // Copies keep the capacity of the original, and have room for the vectors of new entries
+    index.load("tmp.usearch");
+    expect(index.reserve(16));
+    auto copy = index.copy();
+    expect(bool(copy));
+    float vec44[3] = {0.3f, 0.2f, 0.1f};
+    expect(bool(copy.index.add(44, &vec44[0])));
+    expect(copy.index.search(&vec44[0], 1)[0].member.label == 44);
+
+    // Threads beyond the hardware concurrency get their own buffers
+    std::size_t threads = std::thread::hardware_concurrency() + 2;
+    expect(index.reserve(index_limits_t(64, threads)));
+    search_config_t last_thread;
+    last_thread.thread = threads - 1;
+    expect(index.search(&vec43[0], 1, last_thread)[0].member.label == 43);
+
+    // Range search reranks every match in range, not just the `expansion` closest candidates
+    for (std::size_t i = 0; i != 32; ++i) {
+        float nearby[3] = {0.1f, 0.2f, 0.3f + i * 1e-4f};
+        expect(bool(index.add(100 + i, &nearby[0])));
+    }
+    search_config_t narrow;
+    narrow.expansion = 4;
+    expect(index.search_range(&vec42[0], 1e-2f, narrow).size() == 34);
+
+    // The originals are stored before the nodes are linked, so concurrent searches never rerank stale copies
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, 3, 59);
+    bool cosine = index.metric().kind() == metric_kind_t::cos_k;
+    auto exact = [&](float const* a, float const* b) {
+        float dot = 0, a_norm = 0, b_norm = 0, l2sq = 0;
+        for (std::size_t i = 0; i != 3; ++i)
+            dot += a[i] * b[i], a_norm += a[i] * a[i], b_norm += b[i] * b[i], l2sq += (a[i] - b[i]) * (a[i] - b[i]);
+        return cosine ? 1 - dot / std::sqrt(a_norm * b_norm) : l2sq;
+    };
+    expect(index.reserve(index_limits_t(100 + count, threads)));
+    std::thread inserter([&] {
+        add_config_t second_thread;
+        second_thread.thread = 1;
+        for (std::size_t i = 0; i != count; ++i)
+            index.add(1000 + i, vectors.data() + i * 3, second_thread);
+    });
+    std::size_t mismatches = 0;
+    for (std::size_t i = 0; i != count; ++i) {
+        float const* query = vectors.data() + i * 3;
+        search_result_t result = index.search(query, 4);
+        for (std::size_t j = 0; j != result.size(); ++j) {
+            std::size_t label = result[j].member.label;
+            if (label < 1000)
+                continue;
+            float const* member = vectors.data() + (label - 1000) * 3;
+            mismatches += std::fabs(result[j].distance - exact(query, member)) > 1e-4f;
+        }
+    }
+    inserter.join();
+    expect(mismatches == 0);
+}
+
+template <typename index_at> void test_f32_queries(index_at&& index) {
+
+    using index_t = typename std::remove_reference<index_at>::type;
+    using search_result_t = typename index_t::search_result_t;
+
+    // The query differs from the stored vector only beyond the precision of the stored type
+    float vec42[3] = {0.25f, 0.5f, 0.75f};
+    float vec43[3] = {-0.25f, -0.5f, -0.75f};
+    float query[3] = {0.255f, 0.5f, 0.75f};
+
+    expect(index.metric().accepts_f32_queries());
+    index.reserve(10);
+    index.add(42, &vec42[0]);
+    index.add(43, &vec43[0]);
+
+    // Casted down, the query would have matched the stored vector exactly
+    search_result_t result = index.search(&query[0], 1);
+    expect(result.size() == 1);
+    expect(result[0].member.label == 42);
+    expect(result[0].distance > 0);
+    expect(index.search(&vec42[0], 1)[0].distance == 0);
+
+    std::size_t batch_matches = 0;
+    auto check_batch = [&](std::size_t, search_result_t const& result) {
+        batch_matches += result.size() == 1 && result[0].member.label == 42 && result[0].distance > 0;
+    };
+    expect(bool(index.search_batch(&query[0], 1, 3 * sizeof(float), 1, check_batch)));
+    expect(batch_matches == 1);
+}
+
+/**
+ *  Interleaving the traversals must not change the results, only hide the memory latency.
+ */
+template <typename index_at> void test_search_batch(index_at&& index) {
+
+    using index_t = typename std::remove_reference<index_at>::type;
+    using search_result_t = typename index_t::search_result_t;
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    constexpr std::size_t wanted = 10;
+    std::vector<float> vectors = random_vectors(count, dimensions, 5);
+
+    index.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+        index.add(i, vectors.data() + i * dimensions);
+
+    // Repeated batches reuse the lanes of the thread, and a wider batch grows those
+    std::size_t memory_usage = index.memory_usage();
+    for (std::size_t interleave : {4, 4, 16}) {
+        search_config_t config;
+        config.interleave = interleave;
+        std::size_t batch_matches = 0;
+        auto check_batch = [&](std::size_t query_idx, search_result_t const& result) {
+            std::uint64_t expected[wanted], found[wanted];
+            float const* query = vectors.data() + query_idx * dimensions;
+            std::size_t expected_count = index.search(query, wanted).dump_to(expected);
+            batch_matches += result.dump_to(found) == expected_count &&
+                             std::equal(expected, expected + expected_count, found);
+        };
+        auto result = index.search_batch( //
+            vectors.data(), count, dimensions * sizeof(float), wanted, check_batch, config);
+        expect(bool(result));
+        expect(result.measurements != 0);
+        expect(batch_matches == count);
+    }
+
+    // The lanes outlive the calls, so those are reported with the rest of the index
+    expect(index.memory_usage() > memory_usage);
+}
+
+template <typename index_at> void test_pq(index_at&& index, std::size_t bits) {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 512;
+    std::vector<float> vectors = random_vectors(count, dimensions, 7);
+
+    pq_config_t config;
+    config.subspaces = 4;
+    config.bits = bits;
+    expect(bool(index.train_pq(vectors.data(), count, config)));
+    expect(index.enable_rerank());
+    index.reserve(count);
+
+    // Encoding a batch uses the per-thread buffers, so an oversized executor is refused before that
+    std::vector<std::uint64_t> labels(count);
+    auto rejected = index.add_many(labels.data(), vectors.data(), count, dimensions * sizeof(float), add_config_t{},
+                                   executor_default_t(index.limits().threads() + 1));
+    expect(!rejected);
+    expect(index.size() == 0);
+    rejected.error = nullptr;
+
+    for (std::size_t i = 0; i != count; ++i)
+        index.add(i, vectors.data() + i * dimensions);
+
+    // Most vectors must find themselves, as the reranking resolves shared codes
+    auto count_found = [&] {
+        std::size_t found = 0;
+        for (std::size_t i = 0; i != count; ++i)
+            found += index.search(vectors.data() + i * dimensions, 1)[0].member.label == i;
+        return found;
+    };
+    std::size_t found = count_found();
+    expect(found > count * 9 / 10);
+
+    index.save("tmp.usearch");
+    index.load("tmp.usearch");
+    expect(count_found() == found);
+    index.view("tmp.usearch");
+    expect(count_found() == found);
+}
+
+template <typename index_at> void test_add_many(index_at&& index) {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 11);
+    std::vector<std::uint64_t> labels(count);
+    for (std::size_t i = 0; i != count; ++i)
+        labels[i] = count - i;
+
+    // The first half is added one by one, the second half in bulk on top of it
+    index.reserve(index_limits_t(count, 4));
+    for (std::size_t i = 0; i != count / 2; ++i)
+        index.add(labels[i], vectors.data() + i * dimensions);
+    std::size_t progress_calls = 0;
+    std::mutex progress_mutex;
+    auto progress = [&](std::size_t, std::size_t) {
+        std::unique_lock<std::mutex> lock(progress_mutex);
+        ++progress_calls;
+    };
+    auto result = index.add_many(                                                      //
+        labels.data() + count / 2, vectors.data() + count / 2 * dimensions, count / 2, //
+        dimensions * sizeof(float), add_config_t{}, executor_default_t(4), progress);
+    expect(bool(result));
+    expect(result.new_size == count);
+    expect(result.first_id == count / 2);
+    expect(progress_calls != 0);
+    expect(index.size() == count);
+
+    // Every insertion locks at least its own node, and the totals survive in `stats()`
+    expect(result.lock_acquisitions >= count / 2);
+    expect(index.stats().lock_acquisitions >= count);
+
+    std::size_t found = 0;
+    for (std::size_t i = 0; i != count; ++i)
+        found += index.search(vectors.data() + i * dimensions, 1)[0].member.label == labels[i];
+    expect(found > count * 9 / 10);
+    float reconstructed[dimensions];
+    index.get(labels[count - 1], &reconstructed[0]);
+    expect(std::fabs(reconstructed[0] - vectors[(count - 1) * dimensions]) < 0.1f);
+}
+
+/**
+ *  Inserts the same vector from several threads, so that all of them link to the same few nodes.
+ *  Even on a single core, the threads preempted while holding a lock make the others spin.
+ */
+template <typename index_at> void test_lock_contention(index_at&& index) {
+
+    constexpr std::size_t threads = 4;
+    constexpr std::size_t per_thread = 256;
+    std::vector<float> vector(index.dimensions(), 1.f);
+    index.reserve(index_limits_t(threads * per_thread, threads));
+
+    std::vector<std::thread> inserters;
+    for (std::size_t thread_idx = 0; thread_idx != threads; ++thread_idx)
+        inserters.emplace_back([&, thread_idx] {
+            add_config_t config;
+            config.thread = thread_idx;
+            for (std::size_t i = 0; i != per_thread; ++i)
+                index.add(thread_idx * per_thread + i, vector.data(), config);
+        });
+    for (std::thread& inserter : inserters)
+        inserter.join();
+
+    // The counters are only summed once the writers are done
+    auto stats = index.stats();
+    expect(index.size() == threads * per_thread);
+    expect(stats.lock_acquisitions >= threads * per_thread);
+    expect(stats.lock_spins > 0);
+}
+
+template <typename index_at> void test_build_from_graph(index_at&& index) {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    constexpr std::size_t neighbors_per_row = 16;
+    std::vector<float> vectors = random_vectors(count, dimensions, 19);
+    std::vector<std::uint64_t> labels(count);
+    for (std::size_t i = 0; i != count; ++i)
+        labels[i] = i + 1;
+
+    // Exact kNN graph by brute force, that includes the node itself, like most ground-truth files
+    std::vector<std::uint32_t> neighbors(count * neighbors_per_row);
+    std::vector<std::pair<float, std::uint32_t>> row(count);
+    for (std::size_t i = 0; i != count; ++i) {
+        for (std::size_t j = 0; j != count; ++j) {
+            float distance = 0;
+            for (std::size_t k = 0; k != dimensions; ++k) {
+                float delta = vectors[i * dimensions + k] - vectors[j * dimensions + k];
+                distance += delta * delta;
+            }
+            row[j] = {distance, static_cast<std::uint32_t>(j)};
+        }
+        std::partial_sort(row.begin(), row.begin() + neighbors_per_row, row.end());
+        for (std::size_t j = 0; j != neighbors_per_row; ++j)
+            neighbors[i * neighbors_per_row + j] = row[j].second;
+    }
+    // Padding entries must be skipped
+    neighbors[neighbors_per_row - 1] = static_cast<std::uint32_t>(-1);
+
+    index.reserve(index_limits_t(count, 4));
+    auto result = index.build_from_graph(                                 //
+        labels.data(), vectors.data(), count, dimensions * sizeof(float), //
+        neighbors.data(), neighbors_per_row, add_config_t{}, executor_default_t(4));
+    expect(bool(result));
+    expect(result.new_size == count);
+    expect(result.measurements != 0);
+    expect(index.size() == count);
+    expect_self_matches(index, vectors, dimensions, [](std::size_t i) { return i + 1; });
+
+    // Reusing the precomputed rows must take fewer distance measurements, than searching for the neighbors
+    auto searched = index.fork().index;
+    searched.reserve(index_limits_t(count, 4));
+    auto searched_result = searched.add_many(                             //
+        labels.data(), vectors.data(), count, dimensions * sizeof(float), //
+        add_config_t{}, executor_default_t(4));
+    expect(bool(searched_result));
+    expect(result.measurements < searched_result.measurements);
+
+    // Only empty indexes can be built from a graph
+    auto repeated = index.build_from_graph(                               //
+        labels.data(), vectors.data(), count, dimensions * sizeof(float), //
+        neighbors.data(), neighbors_per_row, add_config_t{}, executor_default_t(4));
+    expect(!repeated);
+    repeated.error = nullptr;
+    expect(index.size() == count);
+}
+
+template <typename index_at> void test_merge(index_at&& index, scalar_kind_t accuracy) {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 23);
+
+    // Build the halves separately, as if on different machines
+    auto donor = index.fork().index;
+    index.reserve(index_limits_t(count, 4));
+    donor.reserve(index_limits_t(count / 2, 1));
+    for (std::size_t i = 0; i != count / 2; ++i)
+        index.add(i, vectors.data() + i * dimensions);
+    for (std::size_t i = count / 2; i != count; ++i)
+        donor.add(i, vectors.data() + i * dimensions);
+
+    // Donors with another metric would be searched with the wrong distances
+    metric_kind_t other_metric =
+        index.metric().kind() == metric_kind_t::l2sq_k ? metric_kind_t::ip_k : metric_kind_t::l2sq_k;
+    auto stranger = std::decay<index_at>::type::make(dimensions, other_metric, {}, accuracy);
+    stranger.reserve(index_limits_t(1, 1));
+    stranger.add(count, vectors.data());
+    auto rejected = index.merge(stranger);
+    expect(!rejected);
+    rejected.error = nullptr;
+    expect(index.size() == count / 2);
+
+    auto result = index.merge(donor, add_config_t{}, executor_default_t(4));
+    expect(bool(result));
+    expect(result.first_id == count / 2);
+    expect(result.new_size == count);
+    expect(index.size() == count);
+    donor.clear();
+
+    // The merged entries must be reachable both by search and by their labels
+    expect_self_matches(index, vectors, dimensions, [](std::size_t i) { return i; });
+    float reconstructed[dimensions];
+    for (std::size_t i = count / 2; i != count; ++i) {
+        expect(index.contains(i));
+        expect(index.get(i, &reconstructed[0]));
+        expect(std::fabs(reconstructed[0] - vectors[i * dimensions]) < 0.1f);
+    }
+    expect(!index.contains(count));
+}
+
+void test_sharded(metric_kind_t metric, scalar_kind_t accuracy) {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 29);
+    std::vector<std::uint64_t> labels(count);
+    for (std::size_t i = 0; i != count; ++i)
+        labels[i] = i * 7;
+
+    // The first half is added one by one, the second half in bulk, filling the shards in parallel
+    using index_t = index_sharded_gt<std::uint64_t, std::uint32_t>;
+    index_t index = index_t::make(4, dimensions, metric, {}, accuracy);
+    index.reserve(index_limits_t(count, 4));
+    for (std::size_t i = 0; i != count / 2; ++i)
+        expect(bool(index.add(labels[i], vectors.data() + i * dimensions)));
+    auto result = index.add_many(                                                      //
+        labels.data() + count / 2, vectors.data() + count / 2 * dimensions, count / 2, //
+        dimensions * sizeof(float), executor_default_t(4));
+    expect(bool(result));
+    expect(index.size() == count);
+    for (std::size_t shard_idx = 0; shard_idx != index.shards_count(); ++shard_idx)
+        expect(index.shard(shard_idx).size() != 0);
+
+    std::size_t found = 0;
+    for (std::size_t i = 0; i != count; ++i) {
+        auto matches = index.search(vectors.data() + i * dimensions, 10, executor_default_t(4));
+        expect(matches.size() == 10);
+        expect(std::is_sorted(matches.distances.begin(), matches.distances.end()));
+        found += matches.labels[0] == labels[i];
+    }
+    expect(found > count * 9 / 10);
+
+    float reconstructed[dimensions];
+    expect(index.get(labels[count - 1], &reconstructed[0]));
+    expect(std::fabs(reconstructed[0] - vectors[(count - 1) * dimensions]) < 0.1f);
+    expect(bool(index.remove(labels[0])));
+    expect(!index.contains(labels[0]));
+    expect(index.contains(labels[1]));
+
+    index.save("tmp.usearch");
+    index_t loaded = index_t::make(4, dimensions, metric, {}, accuracy);
+    expect(bool(loaded.load("tmp.usearch")));
+    expect(loaded.size() == count - 1);
+    expect_same_matches(index, loaded, vectors, dimensions);
+
+    // Without shards, there is nowhere to route the entries to
+    index_t empty = index_t::make(0, dimensions, metric, {}, accuracy);
+    expect(empty.shards_count() == 0);
+    expect(!empty.reserve(index_limits_t(count, 4)));
+    auto rejected = empty.add(labels[0], vectors.data());
+    expect(!rejected);
+    rejected.error = nullptr;
+    auto rejected_many = empty.add_many(labels.data(), vectors.data(), count, dimensions * sizeof(float));
+    expect(!rejected_many);
+    rejected_many.error = nullptr;
+    auto rejected_search = empty.search(vectors.data(), 10);
+    expect(!rejected_search);
+    rejected_search.error = nullptr;
+    expect(!empty.contains(labels[0]));
+}
+
+template <typename index_at> void test_refine_graph(index_at&& index) {
+
+    constexpr std::size_t dimensions = 16;
+    constexpr std::size_t count = 2048;
+    constexpr std::size_t wanted = 10;
+    std::vector<float> vectors = random_vectors(count, dimensions, 13);
+    std::vector<float> queries = random_vectors(256, dimensions, 14);
+
+    // Build a poor graph on purpose, and search it with a narrow beam
+    index.reserve(index_limits_t(count, 4));
+    index.change_expansion_add(4);
+    index.change_expansion_search(8);
+    for (std::size_t i = 0; i != count; ++i)
+        index.add(i, vectors.data() + i * dimensions);
+
+    // Counts the approximate matches of unseen queries, that are among the exact nearest neighbors
+    auto count_recalled = [&] {
+        search_config_t exact;
+        exact.exact = true;
+        std::size_t recalled = 0;
+        for (std::size_t i = 0; i != queries.size() / dimensions; ++i) {
+            std::uint64_t expected[wanted], found[wanted];
+            float const* query = queries.data() + i * dimensions;
+            std::size_t expected_count = index.search(query, wanted, exact).dump_to(expected);
+            std::size_t found_count = index.search(query, wanted).dump_to(found);
+            for (std::size_t j = 0; j != found_count; ++j)
+                recalled += std::count(expected, expected + expected_count, found[j]);
+        }
+        return recalled;
+    };
+    std::size_t recalled_before = count_recalled();
+
+    // The replaced edges must lead to closer neighbors, so the recall grows
+    auto result = index.refine_graph(executor_default_t(4));
+    expect(bool(result));
+    expect(result.replaced_edges != 0);
+    expect(result.measurements != 0);
+    std::size_t recalled_after = count_recalled();
+    expect(recalled_after > recalled_before);
+    expect(index.stats().edges <= index.stats().max_edges);
+    expect_self_matches(index, vectors, dimensions, [](std::size_t i) { return i; });
+
+    // Repeated passes converge, replacing fewer edges every time
+    auto repeated = index.refine_graph(executor_default_t(4));
+    expect(bool(repeated));
+    expect(repeated.replaced_edges < result.replaced_edges);
+}
+
+template <typename index_at> void test_reorder(index_at&& index, bool rerank) {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 17);
+    auto label_of = [](std::size_t i) { return i * 3; };
+
+    if (rerank)
+        expect(index.enable_rerank());
+    index.reserve(index_limits_t(count, 2));
+    for (std::size_t i = 0; i != count; ++i)
+        index.add(label_of(i), vectors.data() + i * dimensions);
+    index.remove(0);
+    std::size_t found_before = count_self_matches(index, vectors, dimensions, label_of);
+
+    // Labels and vectors must follow their nodes to the new identifiers
+    auto result = index.reorder(executor_default_t(2));
+    expect(bool(result));
+    expect(result.reachable > count / 2);
+    expect(index.size() == count - 1);
+    expect(!index.contains(0));
+    expect(count_self_matches(index, vectors, dimensions, label_of) == found_before);
+    float reconstructed[dimensions];
+    for (std::size_t i = 1; i < count; i += 97) {
+        expect(index.get(label_of(i), &reconstructed[0]));
+        expect(std::fabs(reconstructed[0] - vectors[i * dimensions]) < 0.1f);
+    }
+
+    // The renumbered graph must round-trip through the file unchanged
+    index.save("tmp.usearch");
+    auto loaded = index.fork().index;
+    expect(bool(loaded.load("tmp.usearch")));
+    expect(loaded.size() == count - 1 && !loaded.contains(0));
+    expect_same_matches(index, loaded, vectors, dimensions);
+    expect(bool(index.view("tmp.usearch")));
+    expect_same_matches(loaded, index, vectors, dimensions);
+}
+
+/**
+ *  Caching the distances in the tape must not change the graph, only save the measurements.
+ */
+void test_cached_distances(metric_kind_t metric) {
+
+    constexpr std::size_t dimensions = 16;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 19);
+
+    index_config_t config;
+    config.connectivity = 8;
+    punned_small_t plain = punned_small_t::make(dimensions, metric, config);
+    config.cache_distances = true;
+    punned_small_t cached = punned_small_t::make(dimensions, metric, config);
+    plain.reserve(count);
+    cached.reserve(count);
+    std::size_t plain_measurements = 0, cached_measurements = 0;
+    for (std::size_t i = 0; i != count; ++i) {
+        plain_measurements += plain.add(i, vectors.data() + i * dimensions).measurements;
+        cached_measurements += cached.add(i, vectors.data() + i * dimensions).measurements;
+    }
+    expect(cached_measurements < plain_measurements);
+    expect(cached.stats().allocated_bytes > plain.stats().allocated_bytes);
+    expect_same_matches(plain, cached, vectors, dimensions);
+
+    // Replacing the vectors must refresh the distances, that the neighbors have cached to them
+    std::vector<float> replacements = random_vectors(count / 2, dimensions, 20);
+    for (std::size_t i = 0; i != count / 2; ++i) {
+        expect(bool(plain.remove(i * 2)) && bool(cached.remove(i * 2)));
+        expect(bool(plain.add(i * 2, replacements.data() + i * dimensions)));
+        expect(bool(cached.add(i * 2, replacements.data() + i * dimensions)));
+    }
+    expect(cached.removed_count() == 0);
+    expect_same_matches(plain, cached, vectors, dimensions);
+    expect_same_matches(plain, cached, replacements, dimensions);
+
+    // The layout is recorded in the file header, so a plain index switches to it on load
+    cached.save("tmp.usearch");
+    expect(index_metadata("tmp.usearch").flags == file_head_t::cached_distances_k);
+    punned_small_t loaded = punned_small_t::make(dimensions, metric, {});
+    expect(bool(loaded.load("tmp.usearch")));
+    expect(loaded.config().cache_distances);
+    expect_same_matches(plain, loaded, vectors, dimensions);
+
+    // The stale distances are saved re-measured, so the loaded graph keeps growing like the plain one
+    plain.save("tmp.usearch.plain");
+    punned_small_t plain_loaded = punned_small_t::make(dimensions, metric, {});
+    expect(bool(plain_loaded.load("tmp.usearch.plain")));
+    for (std::size_t i = 0; i != count / 2; ++i) {
+        expect(bool(plain_loaded.remove(i * 2 + 1)) && bool(loaded.remove(i * 2 + 1)));
+        expect(bool(plain_loaded.add(i * 2 + 1, vectors.data() + i * 2 * dimensions)));
+        expect(bool(loaded.add(i * 2 + 1, vectors.data() + i * 2 * dimensions)));
+    }
+    expect_same_matches(plain_loaded, loaded, vectors, dimensions);
+    std::remove("tmp.usearch.plain");
+    expect(bool(cached.view("tmp.usearch")));
+    expect_same_matches(plain, cached, vectors, dimensions);
+}
+
+/**
+ *  Moving the vectors into aligned slots must not change the graph, only their placement.
+ */
+void test_contiguous_vectors() {
+
+    using index_t = index_gt<l2sq_gt<float>, std::int64_t, std::uint32_t>;
+    using view_t = span_gt<float const>;
+    constexpr std::size_t dimensions = 12;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 23);
+
+    index_config_t config;
+    config.connectivity = 8;
+    index_t plain(config);
+    config.contiguous_dimensions = dimensions;
+    index_t contiguous(config);
+    plain.reserve(count / 2);
+    contiguous.reserve(count / 2);
+    for (std::size_t i = 0; i != count; ++i) {
+        // Growing the capacity midway must move the vectors into the new slots
+        if (i == count / 2)
+            plain.reserve(count), contiguous.reserve(count);
+        plain.add(i, view_t{vectors.data() + i * dimensions, dimensions});
+        contiguous.add(i, view_t{vectors.data() + i * dimensions, dimensions});
+    }
+    float longer[dimensions + 1] = {0};
+    auto overflow = contiguous.add(count, view_t{&longer[0], dimensions + 1});
+    expect(!overflow);
+    overflow.error = nullptr;
+
+    auto aligned = [&](index_t const& index) {
+        for (auto member : index) {
+            expect(reinterpret_cast<std::uintptr_t>(member.vector.data()) % 64 == 0);
+            expect(std::equal(member.vector.begin(), member.vector.end(), vectors.data() + member.label * dimensions));
+        }
+    };
+    auto same_results = [&](index_t const& index) {
+        std::int64_t plain_labels[10], contiguous_labels[10];
+        search_config_t exact;
+        exact.exact = true;
+        for (std::size_t i = 0; i < count; i += 7) {
+            view_t query{vectors.data() + i * dimensions, dimensions};
+            std::size_t found = plain.search(query, 10).dump_to(plain_labels);
+            expect(index.search(query, 10).dump_to(contiguous_labels) == found);
+            expect(std::equal(plain_labels, plain_labels + found, contiguous_labels));
+            found = plain.search(query, 10, exact).dump_to(plain_labels);
+            expect(index.search(query, 10, exact).dump_to(contiguous_labels) == found);
+            expect(std::equal(plain_labels, plain_labels + found, contiguous_labels));
+        }
+    };
+    aligned(contiguous);
+    same_results(contiguous);
+
+    auto copy = contiguous.copy();
+    expect(bool(copy));
+    aligned(copy.index);
+    same_results(copy.index);
+
+    // The file format doesn't change, so both layouts can load each others files
+    contiguous.save("tmp.usearch");
+    plain.load("tmp.usearch");
+    contiguous.load("tmp.usearch");
+    aligned(contiguous);
+    same_results(contiguous);
+
+    expect(bool(contiguous.reorder()));
+    aligned(contiguous);
+    contiguous.view("tmp.usearch");
+    same_results(contiguous);
+}
+
+template <typename index_at> void test_churn(index_at&& index) {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    constexpr std::size_t cycles = 4;
+    std::vector<float> vectors = random_vectors(count * (cycles + 1), dimensions, 29);
+
+    index.reserve(index_limits_t(count, 1));
+    for (std::size_t i = 0; i != count; ++i)
+        index.add(i, vectors.data() + i * dimensions);
+
+    // Every cycle replaces half of the members, reusing both the identifiers and the nodes memory
+    for (std::size_t cycle = 1; cycle <= cycles; ++cycle) {
+        for (std::size_t i = cycle % 2; i < count; i += 2) {
+            std::size_t old_label = (cycle - 1) * count + i;
+            if (!index.contains(old_label))
+                old_label -= count;
+            expect(bool(index.remove(old_label)));
+            index.add(cycle * count + i, vectors.data() + (cycle * count + i) * dimensions);
+        }
+    }
+    expect(index.size() == count);
+    expect(index.stats(1).nodes != 0);
+
+    std::size_t found = 0;
+    float reconstructed[dimensions];
+    for (std::size_t label = 0; label != count * (cycles + 1); ++label) {
+        if (!index.contains(label))
+            continue;
+        float const* vector = vectors.data() + label * dimensions;
+        found += index.search(vector, 1)[0].member.label == label;
+        expect(index.get(label, &reconstructed[0]));
+        expect(std::equal(reconstructed, reconstructed + dimensions, vector));
+    }
+    expect(found > count * 9 / 10);
+}
+
+/**
+ *  Searches must keep reading the nodes, that concurrent updates replace, until they return.
+ */
+void test_concurrent_updates() {
+
+    using index_t = index_gt<l2sq_gt<float>, std::int64_t, std::uint32_t>;
+    using view_t = span_gt<float const>;
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    constexpr std::size_t cycles = 4;
+    std::vector<float> vectors = random_vectors(count * (cycles + 1), dimensions, 47);
+
+    index_config_t config;
+    config.connectivity = 8;
+    index_t index(config);
+    index.reserve(index_limits_t(count, 2));
+    for (std::size_t i = 0; i != count; ++i)
+        index.add(i, view_t{vectors.data() + i * dimensions, dimensions});
+
+    // Every cycle replaces all the members, while the other thread keeps searching
+    std::atomic<bool> updating{true};
+    std::thread updater([&] {
+        for (std::size_t cycle = 1; cycle <= cycles; ++cycle)
+            for (std::size_t i = 0; i != count; ++i)
+                index.update(static_cast<std::uint32_t>(i), cycle * count + i,
+                             view_t{vectors.data() + (cycle * count + i) * dimensions, dimensions});
+        updating = false;
+    });
+    search_config_t second_thread;
+    second_thread.thread = 1;
+    // The graph is being relinked, so only the entry point is guaranteed to be found
+    std::int64_t labels[10];
+    for (std::size_t i = 0; updating; i = (i + 1) % (count * (cycles + 1))) {
+        auto result = index.search(view_t{vectors.data() + i * dimensions, dimensions}, 10, second_thread);
+        expect(result.dump_to(labels) != 0);
+    }
+    updater.join();
+
+    std::size_t found = 0;
+    for (std::size_t i = 0; i != count; ++i) {
+        std::size_t label = cycles * count + i;
+        auto result = index.search(view_t{vectors.data() + label * dimensions, dimensions}, 1);
+        found += result[0].member.label == std::int64_t(label);
+    }
+    expect(found > count * 9 / 10);
+}
+
+/**
+ *  Freed blocks are reused by the allocations of the same size, from any lane,
+ *  and the nodes return to the free lists with the sizes, they were allocated with.
+ */
+void test_free_lists() {
+
+    memory_mapping_allocator_t allocator;
+    byte_t* blocks[2] = {allocator.allocate(100, 0), allocator.allocate(100, 1)};
+    std::size_t reserved = allocator.total_reserved();
+    allocator.deallocate(blocks[0], 100);
+    allocator.deallocate(blocks[1], 100);
+    expect(allocator.total_reserved() > reserved);
+    expect(allocator.allocate(200) != blocks[1]);
+    expect(allocator.allocate(100, 3) == blocks[1]);
+    expect(allocator.allocate(100) == blocks[0]);
+
+    // The vectors, that aren't stored, are referenced in the memory of the caller
+    using index_t = index_gt<l2sq_gt<float>, std::int64_t, std::uint32_t, std::allocator<char>, //
+                             memory_mapping_allocator_t>;
+    using view_t = span_gt<float const>;
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count * 2, dimensions, 53);
+    add_config_t external;
+    external.store_vector = false;
+    index_t index;
+    index.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+        index.add(i, view_t{vectors.data() + i * dimensions, dimensions}, external);
+    for (std::size_t i = 0; i != count; ++i)
+        expect(index.at(i).vector.data() == vectors.data() + i * dimensions);
+
+    // Replacing the external vectors with the stored ones must not overrun the recycled blocks
+    for (std::size_t i = 0; i != count; ++i)
+        index.update(static_cast<std::uint32_t>(i), count + i,
+                     view_t{vectors.data() + (count + i) * dimensions, dimensions});
+    std::size_t found = 0;
+    for (std::size_t i = 0; i != count; ++i) {
+        float const* vector = vectors.data() + (count + i) * dimensions;
+        expect(std::equal(vector, vector + dimensions, index.at(i).vector.begin()));
+        found += index.search(view_t{vector, dimensions}, 1)[0].member.label == std::int64_t(count + i);
+    }
+    expect(found > count * 9 / 10);
+
+    // And replacing those back, must reuse the same blocks, without growing the arenas
+    std::size_t allocated = index.tape_allocator().total_allocated();
+    for (std::size_t i = 0; i != count; ++i)
+        index.update(static_cast<std::uint32_t>(i), i, view_t{vectors.data() + i * dimensions, dimensions}, external);
+    for (std::size_t i = 0; i != count; ++i)
+        index.update(static_cast<std::uint32_t>(i), i, view_t{vectors.data() + i * dimensions, dimensions}, external);
+    expect(index.tape_allocator().total_allocated() == allocated);
+}
+
+void test_compressed_base(bool cache_distances) {
+
+    using index_t = index_gt<l2sq_gt<float>, std::int64_t, std::uint32_t>;
+    using view_t = span_gt<float const>;
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 2048;
+    std::vector<float> vectors = random_vectors(count, dimensions, 31);
+
+    auto file_bytes = [](char const* path) {
+        std::FILE* file = std::fopen(path, "rb");
+        std::fseek(file, 0, SEEK_END);
+        long bytes = std::ftell(file);
+        std::fclose(file);
+        return bytes;
+    };
+    auto file_contents = [](char const* path) {
+        std::vector<char> contents;
+        std::FILE* file = std::fopen(path, "rb");
+        for (int c = std::fgetc(file); c != EOF; c = std::fgetc(file))
+            contents.push_back(static_cast<char>(c));
+        std::fclose(file);
+        return contents;
+    };
+    auto build = [&](index_config_t config) {
+        index_t index(config);
+        index.reserve(count);
+        for (std::size_t i = 0; i != count; ++i)
+            index.add(i, view_t{vectors.data() + i * dimensions, dimensions});
+        expect(bool(index.reorder()));
+        return index;
+    };
+
+    index_config_t config;
+    config.cache_distances = cache_distances;
+    build(config).save("tmp.usearch");
+    long plain_bytes = file_bytes("tmp.usearch");
+    config.compressed_base = true;
+    index_t original = build(config);
+    original.save("tmp.usearch");
+    expect(file_bytes("tmp.usearch") < plain_bytes);
+
+    // Viewed lists are decoded on the fly, loaded and copied ones are expanded back, to the same edges
+    auto same_results = [&](index_t const& index) {
+        std::int64_t expected[10], found[10];
+        expect(index.stats().edges == original.stats().edges);
+        expect(index.stats(0).edges == original.stats(0).edges);
+        for (std::size_t i = 0; i < count; i += 5) {
+            view_t query{vectors.data() + i * dimensions, dimensions};
+            std::size_t expected_count = original.search(query, 10).dump_to(expected);
+            expect(index.search(query, 10).dump_to(found) == expected_count);
+            expect(std::equal(expected, expected + expected_count, found));
+        }
+    };
+    index_t viewed(config), loaded;
+    expect(bool(viewed.view("tmp.usearch")));
+    same_results(viewed);
+    expect(bool(loaded.load("tmp.usearch")));
+    same_results(loaded);
+    auto copy = viewed.copy();
+    expect(bool(copy));
+    same_results(copy.index);
+
+    // Saving a view copies the compressed lists as they are, and the expanded ones encode back the same
+    expect(bool(viewed.save("tmp.usearch.packed")));
+    expect(file_contents("tmp.usearch.packed") == file_contents("tmp.usearch"));
+    expect(bool(loaded.save("tmp.usearch.packed")));
+    expect(file_contents("tmp.usearch.packed") == file_contents("tmp.usearch"));
+    std::remove("tmp.usearch.packed");
+
+    // The loaded lists remain mutable
+    float extra[dimensions] = {0};
+    expect(bool(loaded.reserve(count + 1)));
+    expect(bool(loaded.add(count, view_t{&extra[0], dimensions})));
+    expect(loaded.search(view_t{&extra[0], dimensions}, 1)[0].member.label == std::int64_t(count));
+}
+
+void test_id_widths(index_config_t config) {
+
+    using narrow_t = index_punned_dense_gt<std::uint64_t, std::uint32_t>;
+    using wide_t = index_punned_dense_gt<std::uint64_t, uint40_t>;
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 2048;
+    std::vector<float> vectors = random_vectors(count, dimensions, 37);
+
+    narrow_t narrow = narrow_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    narrow.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+        narrow.add(i, vectors.data() + i * dimensions);
+    expect(bool(narrow.remove(0)));
+    narrow.save("tmp.usearch");
+
+    // The 32-bit lists are widened on load, and the 40-bit ones are narrowed back
+    wide_t wide = wide_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    expect(bool(wide.load("tmp.usearch")));
+    expect(wide.size() == count - 1 && !wide.contains(0));
+    expect_same_matches(narrow, wide, vectors, dimensions);
+
+    // The widened lists must fit into the nodes, even if the file claims otherwise
+    if (!config.compressed_base) {
+        std::FILE* file = std::fopen("tmp.usearch", "r+b");
+        std::uint32_t neighbors_count = 0xFFFF;
+        std::fseek(file, 64 + sizeof(std::uint64_t) + sizeof(std::uint32_t) + sizeof(std::int32_t), SEEK_SET);
+        std::fwrite(&neighbors_count, sizeof(neighbors_count), 1, file);
+        std::fclose(file);
+        wide_t corrupt = wide_t::make(dimensions, metric_kind_t::l2sq_k, config);
+        auto corrupt_result = corrupt.load("tmp.usearch");
+        expect(!corrupt_result);
+        corrupt_result.error = nullptr;
+    }
+    wide.save("tmp.usearch");
+    narrow_t narrowed = narrow_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    expect(bool(narrowed.load("tmp.usearch")));
+    expect_same_matches(narrow, narrowed, vectors, dimensions);
+    auto view_result = narrowed.view("tmp.usearch");
+    expect(!view_result);
+    view_result.error = nullptr;
+
+    // The automatic index re-encodes the graph in memory, once switching to the wider IDs
+    punned_auto_t automatic = punned_auto_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    automatic.reserve(count);
+    for (std::size_t i = 0; i != count; ++i)
+        automatic.add(i, vectors.data() + i * dimensions);
+    expect(bool(automatic.remove(0)));
+    expect(!automatic.wide() && automatic.bytes_per_id() == 4);
+    expect_same_matches(narrow, automatic, vectors, dimensions);
+    expect(automatic.promote(index_limits_t(count + 1)));
+    expect(automatic.wide() && automatic.size() == count - 1);
+    expect_same_matches(narrow, automatic, vectors, dimensions);
+    float extra[dimensions] = {0};
+    expect(bool(automatic.add(count, &extra[0])));
+    std::uint64_t extra_label = 0;
+    float extra_distance = 1;
+    expect(automatic.search(&extra[0], 1, &extra_label, &extra_distance) == 1);
+    expect(extra_label == count && extra_distance == 0);
+
+    // Loading picks the narrowest fitting IDs, while viewing keeps those of the file
+    automatic.save("tmp.usearch");
+    punned_auto_t loaded = punned_auto_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    expect(bool(loaded.load("tmp.usearch")));
+    expect(!loaded.wide() && loaded.size() == count);
+    expect_same_matches(automatic, loaded, vectors, dimensions);
+    punned_auto_t viewed = punned_auto_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    expect(bool(viewed.view("tmp.usearch")));
+    expect(viewed.wide() && viewed.size() == count);
+    expect_same_matches(automatic, viewed, vectors, dimensions);
+    expect(bool(viewed.load("tmp.usearch")));
+    expect(!viewed.wide() && viewed.size() == count);
+    expect_same_matches(automatic, viewed, vectors, dimensions);
+}
+
+/**
+ *  Huge pages, locking and interleaving fall back to the regular pages, where unavailable,
+ *  both for the arenas of the nodes and for the memory-mapped files.
+ */
+void test_pages() {
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 41);
+    auto label_of = [](std::size_t i) { return i; };
+
+    index_config_t config;
+    config.pages.huge = config.pages.transparent_huge = true;
+    config.pages.populate = config.pages.lock = config.pages.interleave = true;
+    punned_small_t paged = punned_small_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    paged.reserve(index_limits_t(count, 2));
+    for (std::size_t i = 0; i != count; ++i)
+        expect(bool(paged.add(label_of(i), vectors.data() + i * dimensions)));
+    expect(paged.stats().page_bytes >= 4096);
+    expect_self_matches(paged, vectors, dimensions, label_of);
+
+    paged.save("tmp.usearch");
+    punned_small_t loaded = punned_small_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    expect(bool(loaded.load("tmp.usearch")));
+    expect(loaded.stats().page_bytes >= 4096);
+    expect_same_matches(paged, loaded, vectors, dimensions);
+    expect(bool(loaded.view("tmp.usearch")));
+    expect(loaded.stats().page_bytes >= 4096);
+    expect_same_matches(paged, loaded, vectors, dimensions);
+}
+
+/**
+ *  Pinned threads must still cover every task exactly once, and build the same interleaved index.
+ */
+void test_pinned_threads() {
+
+    std::vector<std::size_t> hits(1000);
+    executor_stl_t(2, true).execute_bulk(hits.size(), [&](std::size_t, std::size_t task) { ++hits[task]; });
+    expect(std::count(hits.begin(), hits.end(), 1u) == 1000);
+    std::vector<std::size_t> threads(4);
+    executor_stl_t(4, true).execute_bulk([&](std::size_t thread) { ++threads[thread]; });
+    expect(std::count(threads.begin(), threads.end(), 1u) == 4);
+
+    constexpr std::size_t dimensions = 8;
+    constexpr std::size_t count = 1024;
+    std::vector<float> vectors = random_vectors(count, dimensions, 43);
+    std::vector<std::uint64_t> labels(count);
+    for (std::size_t i = 0; i != count; ++i)
+        labels[i] = i;
+
+    index_config_t config;
+    config.pages.interleave = true;
+    punned_small_t index = punned_small_t::make(dimensions, metric_kind_t::l2sq_k, config);
+    index.reserve(index_limits_t(count, 4));
+    auto result = index.add_many(                                         //
+        labels.data(), vectors.data(), count, dimensions * sizeof(float), //
+        add_config_t{}, executor_stl_t(4, true));
+    expect(bool(result));
+    expect(index.size() == count);
+    expect_self_matches(index, vectors, dimensions, [](std::size_t i) { return i; });
+}
+
+/**
+ *  Allocations from per-thread lanes must not overlap, and must be accounted like the shared ones.
+ */
+void test_allocator_lanes() {
+
+    memory_mapping_allocator_t allocator;
+    std::vector<byte_t*> blocks(4000);
+    executor_stl_t(4).execute_bulk(blocks.size(), [&](std::size_t thread, std::size_t task) {
+        blocks[task] = allocator.allocate(100, thread);
+        std::memset(blocks[task], static_cast<int>(task % 251), 100);
+    });
+    for (std::size_t task = 0; task != blocks.size(); ++task)
+        expect(std::count(blocks[task], blocks[task] + 100, static_cast<byte_t>(task % 251)) == 100);
+    expect(allocator.total_allocated() >= blocks.size() * 100);
+
+    // The padding of aligned blocks is wasted in the lanes, just like in the shared arenas
+    memory_mapping_allocator_gt<64> aligned_allocator;
+    executor_stl_t(4).execute_bulk(blocks.size(), [&](std::size_t thread, std::size_t task) {
+        blocks[task] = aligned_allocator.allocate(100, thread);
+        expect(reinterpret_cast<std::uintptr_t>(blocks[task]) % 64 == 0);
+    });
+    expect(aligned_allocator.total_wasted() >= blocks.size() * 28);
+    expect(aligned_allocator.total_allocated() >= blocks.size() * 128);
+}
+
+/**
+ *  Once the generations wrap around, both the dense and the hashed sets must forget the older visits.
+ */
+void test_visits_set() {
+    for (std::size_t capacity : {std::size_t(1024), visits_set_gt<>::dense_limit() + 1}) {
+        visits_set_gt<> visits;
+        expect(visits.resize(capacity));
+        expect(visits.dense_limit() < capacity || !visits.hashed());
+        expect(visits.set(7) && visits.test(7));
+        for (std::size_t generation = 0; generation != 1u << 16; ++generation)
+            visits.clear();
+        expect(!visits.test(7));
+        expect(visits.set(9) && visits.test(9));
+    }
+}
+
 template <typename index_at> void test_sets(index_at&& index) {
 
     using index_t = typename std::remove_reference<index_at>::type;
@@ -161,6 +1290,9 @@ int main(int, char**) {
     test3d<double>(index_gt<cos_gt<double>, big_point_id_t, std::uint32_t>{});
     test3d<double>(index_gt<l2sq_gt<double>, big_point_id_t, std::uint32_t>{});
 
+    // Identifiers too wide to be packed with the level fall back to the locked entry point
+    test3d<float>(index_gt<l2sq_gt<float>, big_point_id_t, std::uint64_t>{});
+
     test3d<float>(punned_small_t::make(3, metric_kind_t::cos_k));
     test3d<float>(punned_small_t::make(3, metric_kind_t::l2sq_k));
 
@@ -170,6 +1302,70 @@ int main(int, char**) {
     test3d_punned<float>(punned_small_t::make(3, metric_kind_t::cos_k));
     test3d_punned<float>(punned_small_t::make(3, metric_kind_t::l2sq_k));
 
+    test_rerank(punned_small_t::make(3, metric_kind_t::l2sq_k, {}, scalar_kind_t::f8_k));
+    test_rerank(punned_small_t::make(3, metric_kind_t::cos_k, {}, scalar_kind_t::f16_k));
+
+    test_f32_queries(punned_small_t::make(3, metric_kind_t::l2sq_k, {}, scalar_kind_t::f8_k));
+    test_f32_queries(punned_small_t::make(3, metric_kind_t::l2sq_k, {}, scalar_kind_t::f16_k));
+    test_f32_queries(punned_small_t::make(3, metric_kind_t::cos_k, {}, scalar_kind_t::f8_k));
+
+    test_search_batch(punned_small_t::make(8, metric_kind_t::l2sq_k));
+    test_search_batch(punned_small_t::make(8, metric_kind_t::cos_k, {}, scalar_kind_t::f16_k));
+
+    test_add_many(punned_small_t::make(8, metric_kind_t::l2sq_k));
+    test_add_many(punned_small_t::make(8, metric_kind_t::cos_k, {}, scalar_kind_t::f16_k));
+    test_lock_contention(punned_small_t::make(2, metric_kind_t::l2sq_k));
+
+    test_build_from_graph(punned_small_t::make(8, metric_kind_t::l2sq_k));
+    test_build_from_graph(punned_small_t::make(8, metric_kind_t::cos_k, {}, scalar_kind_t::f16_k));
+
+    test_merge(punned_small_t::make(8, metric_kind_t::l2sq_k), scalar_kind_t::f32_k);
+    test_merge(punned_small_t::make(8, metric_kind_t::cos_k, {}, scalar_kind_t::f16_k), scalar_kind_t::f16_k);
+
+    test_sharded(metric_kind_t::l2sq_k, scalar_kind_t::f32_k);
+    test_sharded(metric_kind_t::cos_k, scalar_kind_t::f16_k);
+
+    index_config_t sparse_config;
+    sparse_config.connectivity = 4;
+    test_refine_graph(punned_small_t::make(16, metric_kind_t::l2sq_k, sparse_config));
+    test_refine_graph(punned_small_t::make(16, metric_kind_t::cos_k, sparse_config, scalar_kind_t::f16_k));
+
+    test_reorder(punned_small_t::make(8, metric_kind_t::l2sq_k), false);
+    test_reorder(punned_small_t::make(8, metric_kind_t::l2sq_k, {}, scalar_kind_t::f8_k), true);
+
+    test_cached_distances(metric_kind_t::l2sq_k);
+    test_cached_distances(metric_kind_t::cos_k);
+
+    test_contiguous_vectors();
+    index_config_t contiguous_config;
+    contiguous_config.contiguous_dimensions = 8;
+    test_reorder(punned_small_t::make(8, metric_kind_t::l2sq_k, contiguous_config), false);
+    test_pq(punned_small_t::make(8, metric_kind_t::l2sq_k, contiguous_config), 8);
+    test_compressed_base(false);
+    test_compressed_base(true);
+
+    test_id_widths({});
+    index_config_t widths_config;
+    widths_config.cache_distances = widths_config.compressed_base = true;
+    test_id_widths(widths_config);
+    test_id_widths(contiguous_config);
+
+    test_pages();
+
+    test_pinned_threads();
+
+    test_allocator_lanes();
+
+    test_visits_set();
+
+    test_pq(punned_small_t::make(8, metric_kind_t::l2sq_k), 8);
+    test_pq(punned_small_t::make(8, metric_kind_t::cos_k), 4);
+
+    test_churn(punned_small_t::make(8, metric_kind_t::l2sq_k));
+    test_churn(punned_small_t::make(8, metric_kind_t::l2sq_k, contiguous_config));
+    test_concurrent_updates();
+    test_free_lists();
+
     test_sets(index_gt<jaccard_gt<std::int32_t, float>, big_point_id_t, std::uint32_t>{});
     test_sets(index_gt<jaccard_gt<std::int64_t, float>, big_point_id_t, std::uint32_t>{});
 
@@ -66,6 +66,9 @@
 #include <sys/mman.h> // `mmap`
 #include <sys/stat.h> // `fstat` for file size
 #include <unistd.h>   // `open`, `close`
+#if defined(USEARCH_DEFINED_LINUX)
+#include <sys/syscall.h> // `SYS_mbind`
+#endif
 #endif
 
 // STL includes
@@ -303,6 +306,40 @@ template <typename scalar_at = float, typename result_at = scalar_at> struct ip_
             ab += result_t(a[i]) * result_t(b[i]);
         return 1 - ab;
     }
+
+    /**
+     *  @brief  Computes the distances from one ::query to ::count ::candidates at once,
+     *          reusing every loaded query scalar across a group of four candidates.
+     */
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count, result_t* results) const noexcept {
+        scalar_t const* a = query.data();
+        std::size_t const dim = query.size();
+        std::size_t idx = 0;
+        for (; idx + 4 <= count; idx += 4) {
+            scalar_t const* b0 = candidates[idx + 0];
+            scalar_t const* b1 = candidates[idx + 1];
+            scalar_t const* b2 = candidates[idx + 2];
+            scalar_t const* b3 = candidates[idx + 3];
+            result_t ab0{}, ab1{}, ab2{}, ab3{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : ab0, ab1, ab2, ab3)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t i = 0; i != dim; ++i) {
+                result_t ai = result_t(a[i]);
+                ab0 += ai * result_t(b0[i]), ab1 += ai * result_t(b1[i]), //
+                    ab2 += ai * result_t(b2[i]), ab3 += ai * result_t(b3[i]);
+            }
+            results[idx + 0] = 1 - ab0, results[idx + 1] = 1 - ab1;
+            results[idx + 2] = 1 - ab2, results[idx + 3] = 1 - ab3;
+        }
+        for (; idx != count; ++idx)
+            results[idx] = operator()(a, candidates[idx], dim);
+    }
 };
 
 /**
@@ -336,6 +373,71 @@ template <typename scalar_at = float, typename result_at = scalar_at> struct cos
                 b2 += square<result_t>(b[i]);
         return (ab != 0) ? (1 - ab / (std::sqrt(a2) * std::sqrt(b2))) : 1;
     }
+
+    /**
+     *  @brief  Computes the distances from one ::query to ::count ::candidates at once,
+     *          normalizing the query only once and reusing every loaded query scalar
+     *          across a group of four candidates.
+     */
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count, result_t* results) const noexcept {
+        scalar_t const* a = query.data();
+        std::size_t const dim = query.size();
+        result_t a2{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : a2)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+        for (std::size_t i = 0; i != dim; ++i)
+            a2 += square<result_t>(a[i]);
+        result_t const a_norm = std::sqrt(a2);
+
+        auto normalize = [=](result_t ab, result_t b2) -> result_t {
+            return (ab != 0) ? (1 - ab / (a_norm * std::sqrt(b2))) : 1;
+        };
+        std::size_t idx = 0;
+        for (; idx + 4 <= count; idx += 4) {
+            scalar_t const* b0 = candidates[idx + 0];
+            scalar_t const* b1 = candidates[idx + 1];
+            scalar_t const* b2 = candidates[idx + 2];
+            scalar_t const* b3 = candidates[idx + 3];
+            result_t ab0{}, ab1{}, ab2{}, ab3{};
+            result_t b0_sq{}, b1_sq{}, b2_sq{}, b3_sq{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : ab0, ab1, ab2, ab3, b0_sq, b1_sq, b2_sq, b3_sq)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t i = 0; i != dim; ++i) {
+                result_t ai = result_t(a[i]);
+                result_t b0i = result_t(b0[i]), b1i = result_t(b1[i]), b2i = result_t(b2[i]), b3i = result_t(b3[i]);
+                ab0 += ai * b0i, ab1 += ai * b1i, ab2 += ai * b2i, ab3 += ai * b3i;
+                b0_sq += b0i * b0i, b1_sq += b1i * b1i, b2_sq += b2i * b2i, b3_sq += b3i * b3i;
+            }
+            results[idx + 0] = normalize(ab0, b0_sq), results[idx + 1] = normalize(ab1, b1_sq);
+            results[idx + 2] = normalize(ab2, b2_sq), results[idx + 3] = normalize(ab3, b3_sq);
+        }
+        for (; idx != count; ++idx) {
+            scalar_t const* b = candidates[idx];
+            result_t ab{}, b2{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : ab, b2)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t i = 0; i != dim; ++i)
+                ab += result_t(a[i]) * result_t(b[i]), //
+                    b2 += square<result_t>(b[i]);
+            results[idx] = normalize(ab, b2);
+        }
+    }
 };
 
 /**
@@ -365,6 +467,40 @@ template <typename scalar_at = float, typename result_at = scalar_at> struct l2s
             ab_deltas_sq += square(result_t(a[i]) - result_t(b[i]));
         return ab_deltas_sq;
     }
+
+    /**
+     *  @brief  Computes the distances from one ::query to ::count ::candidates at once,
+     *          reusing every loaded query scalar across a group of four candidates.
+     */
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count, result_t* results) const noexcept {
+        scalar_t const* a = query.data();
+        std::size_t const dim = query.size();
+        std::size_t idx = 0;
+        for (; idx + 4 <= count; idx += 4) {
+            scalar_t const* b0 = candidates[idx + 0];
+            scalar_t const* b1 = candidates[idx + 1];
+            scalar_t const* b2 = candidates[idx + 2];
+            scalar_t const* b3 = candidates[idx + 3];
+            result_t d0{}, d1{}, d2{}, d3{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : d0, d1, d2, d3)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t i = 0; i != dim; ++i) {
+                result_t ai = result_t(a[i]);
+                d0 += square(ai - result_t(b0[i])), d1 += square(ai - result_t(b1[i])), //
+                    d2 += square(ai - result_t(b2[i])), d3 += square(ai - result_t(b3[i]));
+            }
+            results[idx + 0] = d0, results[idx + 1] = d1;
+            results[idx + 2] = d2, results[idx + 3] = d3;
+        }
+        for (; idx != count; ++idx)
+            results[idx] = operator()(a, candidates[idx], dim);
+    }
 };
 
 /**
@@ -656,7 +792,10 @@ template <typename allocator_at = std::allocator<char>> class visits_bitset_gt {
   public:
     visits_bitset_gt() noexcept {}
     ~visits_bitset_gt() noexcept { reset(); }
-    void clear() noexcept { std::memset(slots_, 0, count_ * sizeof(slot_t)); }
+    void clear() noexcept {
+        if (slots_)
+            std::memset(slots_, 0, count_ * sizeof(slot_t));
+    }
 
     void reset() noexcept {
         if (slots_)
@@ -665,6 +804,10 @@ template <typename allocator_at = std::allocator<char>> class visits_bitset_gt {
         count_ = 0;
     }
 
+    /**
+     *  @brief  Grows to fit ::capacity bits, keeping the ones already set.
+     *  @return `true` on success, `false` on memory allocation errors.
+     */
     bool resize(std::size_t capacity) noexcept {
 
         std::size_t count = divide_round_up<bits_per_slot()>(capacity);
@@ -675,10 +818,12 @@ template <typename allocator_at = std::allocator<char>> class visits_bitset_gt {
         if (!slots)
             return false;
 
+        std::memset(slots, 0, count * sizeof(slot_t));
+        if (slots_)
+            std::memcpy(slots, slots_, count_ * sizeof(slot_t));
         reset();
         count_ = count;
         slots_ = slots;
-        clear();
         return true;
     }
 
@@ -711,6 +856,11 @@ template <typename allocator_at = std::allocator<char>> class visits_bitset_gt {
         InterlockedAnd((long volatile*)&slots_[i / bits_per_slot()], ~mask);
     }
 
+    inline bool atomic_test(std::size_t i) const noexcept {
+        slot_t mask{1ul << (i & bits_mask())};
+        return *(long volatile const*)&slots_[i / bits_per_slot()] & mask;
+    }
+
 #else
 
     inline bool atomic_set(std::size_t i) noexcept {
@@ -723,11 +873,337 @@ template <typename allocator_at = std::allocator<char>> class visits_bitset_gt {
         __atomic_fetch_and(&slots_[i / bits_per_slot()], ~mask, __ATOMIC_RELEASE);
     }
 
+    inline bool atomic_test(std::size_t i) const noexcept {
+        slot_t mask{1ul << (i & bits_mask())};
+        return __atomic_load_n(&slots_[i / bits_per_slot()], __ATOMIC_RELAXED) & mask;
+    }
+
 #endif
 };
 
 using visits_bitset_t = visits_bitset_gt<>;
 
+/**
+ *  @brief  Hints the CPU, that the current thread is busy-waiting,
+ *          letting the sibling hyper-thread run and saving power.
+ */
+inline void spin_pause() noexcept {
+#if defined(USEARCH_DEFINED_WINDOWS)
+    YieldProcessor();
+#elif defined(USEARCH_DEFINED_X86)
+    __builtin_ia32_pause();
+#elif defined(USEARCH_DEFINED_ARM)
+    asm volatile("yield");
+#endif
+}
+
+/**
+ *  @brief  Exponential backoff for spin-locks. Pauses for a doubling number of iterations,
+ *          and, once the lock is clearly held for long, yields the time slice to the OS,
+ *          so that the threads queued on a hub node don't burn whole cores.
+ */
+class spin_backoff_t {
+    std::size_t pauses_ = 1;
+
+  public:
+    static constexpr std::size_t max_pauses_k = 64;
+
+    inline void wait() noexcept {
+        if (pauses_ > max_pauses_k) {
+            std::this_thread::yield();
+            return;
+        }
+        for (std::size_t i = 0; i != pauses_; ++i)
+            spin_pause();
+        pauses_ *= 2;
+    }
+};
+
+/**
+ *  @brief  Tracks visited nodes during a single graph traversal, without an O(N) reset per query.
+ *
+ *  Every traversal gets a new 16-bit generation number, and a node is considered visited only
+ *  if it's stamped with the current one. Small indexes use a dense array of stamps, that is only
+ *  wiped once every 65'535 traversals. Large indexes use an open-addressing hash-set of stamped
+ *  IDs, that grows with the number of visited nodes, rather than with the size of the index.
+ *  The variant is picked by `resize()`, depending on the number of members.
+ */
+template <typename allocator_at = std::allocator<char>> class visits_set_gt {
+    using allocator_t = allocator_at;
+    using byte_t = typename allocator_t::value_type;
+    static_assert(sizeof(byte_t) == 1, "Allocator must allocate separate addressable bytes");
+
+    using epoch_t = std::uint16_t;
+    /// @brief Hash-set entries pack the node ID on top of the generation number. Zero means empty.
+    using slot_t = std::uint64_t;
+
+    static constexpr std::size_t epoch_bits() { return sizeof(epoch_t) * CHAR_BIT; }
+    static constexpr slot_t epoch_mask() { return (slot_t(1) << epoch_bits()) - 1; }
+
+    epoch_t* epochs_{};
+    std::size_t epochs_count_{};
+    slot_t* slots_{};
+    std::size_t slots_count_{};
+    std::size_t population_{};
+    epoch_t epoch_{};
+
+  public:
+    /**
+     *  @brief  Largest index, that will track visits in a dense array of stamps.
+     *          At 2 bytes per member that's 8 MB per thread.
+     */
+    static constexpr std::size_t dense_limit() { return 1ul << 22; }
+    static constexpr std::size_t hashed_initial_slots() { return 1024; }
+
+    visits_set_gt() noexcept {}
+    ~visits_set_gt() noexcept { reset(); }
+
+    visits_set_gt(visits_set_gt&& other) noexcept { swap(other); }
+    visits_set_gt& operator=(visits_set_gt&& other) noexcept {
+        swap(other);
+        return *this;
+    }
+
+    visits_set_gt(visits_set_gt const&) = delete;
+    visits_set_gt& operator=(visits_set_gt const&) = delete;
+
+    void swap(visits_set_gt& other) noexcept {
+        std::swap(epochs_, other.epochs_);
+        std::swap(epochs_count_, other.epochs_count_);
+        std::swap(slots_, other.slots_);
+        std::swap(slots_count_, other.slots_count_);
+        std::swap(population_, other.population_);
+        std::swap(epoch_, other.epoch_);
+    }
+
+    void reset() noexcept {
+        if (epochs_)
+            allocator_t{}.deallocate((byte_t*)epochs_, epochs_count_ * sizeof(epoch_t));
+        if (slots_)
+            allocator_t{}.deallocate((byte_t*)slots_, slots_count_ * sizeof(slot_t));
+        epochs_ = nullptr;
+        epochs_count_ = 0;
+        slots_ = nullptr;
+        slots_count_ = 0;
+        population_ = 0;
+        epoch_ = 0;
+    }
+
+    bool hashed() const noexcept { return slots_ != nullptr; }
+    std::size_t memory_usage() const noexcept {
+        return epochs_count_ * sizeof(epoch_t) + slots_count_ * sizeof(slot_t);
+    }
+
+    /**
+     *  @brief  Prepares to track visits in an index with up to ::capacity members.
+     *  @return `true` on success, `false` on memory allocation errors.
+     */
+    bool resize(std::size_t capacity) noexcept {
+        if (capacity <= dense_limit()) {
+            if (capacity <= epochs_count_)
+                return true;
+            epoch_t* epochs = (epoch_t*)allocator_t{}.allocate(capacity * sizeof(epoch_t));
+            if (!epochs)
+                return false;
+            reset();
+            epochs_ = epochs;
+            epochs_count_ = capacity;
+            std::memset(epochs_, 0, epochs_count_ * sizeof(epoch_t));
+        } else {
+            if (hashed())
+                return true;
+            slot_t* slots = (slot_t*)allocator_t{}.allocate(hashed_initial_slots() * sizeof(slot_t));
+            if (!slots)
+                return false;
+            reset();
+            slots_ = slots;
+            slots_count_ = hashed_initial_slots();
+            std::memset(slots_, 0, slots_count_ * sizeof(slot_t));
+        }
+        epoch_ = 1;
+        return true;
+    }
+
+    /**
+     *  @brief  Forgets all the visits, by starting a new generation.
+     *          Only touches the memory once the generation counter overflows.
+     */
+    void clear() noexcept {
+        population_ = 0;
+        if (++epoch_)
+            return;
+        if (epochs_)
+            std::memset(epochs_, 0, epochs_count_ * sizeof(epoch_t));
+        if (slots_)
+            std::memset(slots_, 0, slots_count_ * sizeof(slot_t));
+        epoch_ = 1;
+    }
+
+    inline bool test(std::size_t i) const noexcept {
+        if (!slots_)
+            return epochs_[i] == epoch_;
+
+        slot_t wanted = stamp(i);
+        std::size_t mask = slots_count_ - 1;
+        for (std::size_t idx = hash(i) & mask;; idx = (idx + 1) & mask) {
+            slot_t slot = slots_[idx];
+            if (slot == wanted)
+                return true;
+            if ((slot & epoch_mask()) != epoch_)
+                return false;
+        }
+    }
+
+    /**
+     *  @brief  Marks the ::i-th node as visited.
+     *  @return `false` if the hash-set needed to grow, but memory allocation failed.
+     */
+    inline bool set(std::size_t i) noexcept {
+        if (!slots_) {
+            epochs_[i] = epoch_;
+            return true;
+        }
+
+        if ((population_ + 1) * 2 > slots_count_ && !grow())
+            return false;
+        insert(stamp(i));
+        return true;
+    }
+
+  private:
+    inline slot_t stamp(std::size_t i) const noexcept { return (slot_t(i) << epoch_bits()) | epoch_; }
+    inline static std::size_t hash(std::size_t i) noexcept {
+        // Fibonacci hashing, keeping the upper well-mixed bits.
+        return static_cast<std::size_t>((std::uint64_t(i) * 0x9E3779B97F4A7C15ull) >> 24);
+    }
+
+    /// @brief  Linear probing until an empty or a stale slot.
+    inline void insert(slot_t stamped) noexcept {
+        std::size_t mask = slots_count_ - 1;
+        std::size_t idx = hash(static_cast<std::size_t>(stamped >> epoch_bits())) & mask;
+        for (;; idx = (idx + 1) & mask) {
+            slot_t slot = slots_[idx];
+            if (slot == stamped)
+                return;
+            if ((slot & epoch_mask()) != epoch_)
+                break;
+        }
+        slots_[idx] = stamped;
+        population_++;
+    }
+
+    bool grow() noexcept {
+        std::size_t old_count = slots_count_;
+        slot_t* old_slots = slots_;
+        slot_t* slots = (slot_t*)allocator_t{}.allocate(old_count * 2 * sizeof(slot_t));
+        if (!slots)
+            return false;
+
+        std::memset(slots, 0, old_count * 2 * sizeof(slot_t));
+        slots_ = slots;
+        slots_count_ = old_count * 2;
+        population_ = 0;
+        for (std::size_t idx = 0; idx != old_count; ++idx)
+            if ((old_slots[idx] & epoch_mask()) == epoch_)
+                insert(old_slots[idx]);
+        allocator_t{}.deallocate((byte_t*)old_slots, old_count * sizeof(slot_t));
+        return true;
+    }
+};
+
+/**
+ *  @brief  Array of sequence counters, one per node, allowing readers to copy the neighbors lists
+ *          without taking any locks. Writers make the counter odd before modifying the list and even
+ *          afterwards. Readers retry, if the counter was odd or has changed during their copy.
+ *
+ *  Writers must already have an exclusive access to the node, as the counter itself is not a lock.
+ */
+template <typename allocator_at = std::allocator<char>> class versions_gt {
+    using allocator_t = allocator_at;
+    using byte_t = typename allocator_t::value_type;
+    static_assert(sizeof(byte_t) == 1, "Allocator must allocate separate addressable bytes");
+
+  public:
+    using version_t = std::uint32_t;
+
+  private:
+    using slot_t = std::atomic<version_t>;
+    static_assert(std::is_trivially_destructible<slot_t>(), "Slots are deallocated without destruction");
+
+    slot_t* slots_{};
+    std::size_t count_{};
+
+  public:
+    versions_gt() noexcept {}
+    ~versions_gt() noexcept { reset(); }
+
+    void reset() noexcept {
+        if (slots_)
+            allocator_t{}.deallocate((byte_t*)slots_, count_ * sizeof(slot_t));
+        slots_ = nullptr;
+        count_ = 0;
+    }
+
+    /**
+     *  @brief  Grows the array to fit at least ::capacity nodes, zeroing all the counters.
+     *  @return `true` on success, `false` on memory allocation errors.
+     */
+    bool resize(std::size_t capacity) noexcept {
+        if (capacity <= count_)
+            return true;
+
+        slot_t* slots = (slot_t*)allocator_t{}.allocate(capacity * sizeof(slot_t));
+        if (!slots)
+            return false;
+
+        reset();
+        for (std::size_t i = 0; i != capacity; ++i)
+            new (slots + i) slot_t(0);
+        slots_ = slots;
+        count_ = capacity;
+        return true;
+    }
+
+    versions_gt(versions_gt&& other) noexcept {
+        std::swap(slots_, other.slots_);
+        std::swap(count_, other.count_);
+    }
+
+    versions_gt& operator=(versions_gt&& other) noexcept {
+        std::swap(slots_, other.slots_);
+        std::swap(count_, other.count_);
+        return *this;
+    }
+
+    versions_gt(versions_gt const&) = delete;
+    versions_gt& operator=(versions_gt const&) = delete;
+
+    std::size_t memory_usage() const noexcept { return count_ * sizeof(slot_t); }
+
+    /// @brief  Waits for concurrent writers to finish, returning the version to validate the read with.
+    inline version_t read_begin(std::size_t i) const noexcept {
+        version_t version = slots_[i].load(std::memory_order_acquire);
+        while (version & 1u)
+            version = slots_[i].load(std::memory_order_acquire);
+        return version;
+    }
+
+    /// @brief  Checks if the data read since `read_begin` may have been modified concurrently.
+    inline bool read_retry(std::size_t i, version_t version) const noexcept {
+        std::atomic_thread_fence(std::memory_order_acquire);
+        return slots_[i].load(std::memory_order_relaxed) != version;
+    }
+
+    inline void write_begin(std::size_t i) noexcept {
+        slots_[i].store(slots_[i].load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+    }
+
+    inline void write_end(std::size_t i) noexcept {
+        slots_[i].store(slots_[i].load(std::memory_order_relaxed) + 1u, std::memory_order_release);
+    }
+};
+
 /**
  *  @brief  Similar to `std::priority_queue`, but allows raw access to underlying
  *          memory, in case you want to shuffle it or sort. Good for collections
@@ -1006,7 +1482,10 @@ class usearch_pack_m uint40_t {
 
   public:
     inline uint40_t() noexcept { broadcast(0); }
-    inline uint40_t(std::uint32_t n) noexcept { std::memcpy(octets, (char*)&n, 4); }
+    inline uint40_t(std::uint32_t n) noexcept {
+        std::memcpy(octets, (char*)&n, 4);
+        octets[4] = 0;
+    }
     inline uint40_t(std::uint64_t n) noexcept { std::memcpy(octets, (char*)&n, 5); }
 #if defined(USEARCH_DEFINED_CLANG) && defined(USEARCH_DEFINED_APPLE)
     inline uint40_t(std::size_t n) noexcept { std::memcpy(octets, (char*)&n, 5); }
@@ -1043,9 +1522,9 @@ class usearch_pack_m uint40_t {
     inline operator std::size_t() const noexcept {
         std::size_t result = 0;
 #ifdef USEARCH_64BIT_ENV
-        std::memcpy((char*)&result + 3, octets, 5);
+        std::memcpy((char*)&result, octets, 5);
 #else
-        std::memcpy((char*)&result, octets + 1, 4);
+        std::memcpy((char*)&result, octets, 4);
 #endif
         return result;
     }
@@ -1185,37 +1664,239 @@ class ring_gt {
     element_t const& operator[](std::size_t i) const noexcept { return elements_[(tail_ + i) % capacity_]; }
 };
 
-/// @brief Number of neighbors per graph node.
-/// Defaults to 32 in FAISS and 16 in hnswlib.
-/// > It is called `M` in the paper.
-constexpr std::size_t default_connectivity() { return 16; }
+/**
+ *  @brief  Growing array of trivial structs, used as scratch space by the threads.
+ *          Unlike `std::vector`, doesn't initialize the elements and doesn't throw.
+ */
+template <typename element_at, typename allocator_at = std::allocator<element_at>> //
+class buffer_gt {
+  public:
+    using element_t = element_at;
+    using allocator_t = allocator_at;
 
-/// @brief Hyper-parameter controlling the quality of indexing.
-/// Defaults to 40 in FAISS and 200 in hnswlib.
-/// > It is called `efConstruction` in the paper.
-constexpr std::size_t default_expansion_add() { return 128; }
+    static_assert(std::is_trivially_destructible<element_t>(), "This buffer is designed for trivial structs");
+    static_assert(std::is_trivially_copy_constructible<element_t>(), "This buffer is designed for trivial structs");
 
-/// @brief Hyper-parameter controlling the quality of search.
-/// Defaults to 16 in FAISS and 10 in hnswlib.
-/// > It is called `ef` in the paper.
-constexpr std::size_t default_expansion_search() { return 64; }
+    using value_type = element_t;
 
-constexpr std::size_t default_allocator_entry_bytes() { return 64; }
+  private:
+    element_t* elements_{};
+    std::size_t size_{};
 
-/**
- *  @brief  The "magic" sequence helps infer the type of the file.
- *          USearch indexes start with the "usearch" string.
- */
-constexpr char const* default_magic() { return "usearch"; }
+  public:
+    buffer_gt() noexcept {}
+    ~buffer_gt() noexcept { reset(); }
 
-/**
- *  @brief  Configuration settings for the index construction.
- *          Includes the main `::connectivity` parameter (`M` in the paper)
- *          and two expansion factors - for construction and search.
- */
-struct index_config_t {
-    /// @brief Number of neighbors per graph node.
-    /// Defaults to 32 in FAISS and 16 in hnswlib.
+    buffer_gt(buffer_gt&& other) noexcept
+        : elements_(exchange(other.elements_, nullptr)), size_(exchange(other.size_, 0)) {}
+
+    buffer_gt& operator=(buffer_gt&& other) noexcept {
+        std::swap(elements_, other.elements_);
+        std::swap(size_, other.size_);
+        return *this;
+    }
+
+    buffer_gt(buffer_gt const&) = delete;
+    buffer_gt& operator=(buffer_gt const&) = delete;
+
+    void reset() noexcept {
+        if (elements_)
+            allocator_t{}.deallocate(elements_, size_);
+        elements_ = nullptr;
+        size_ = 0;
+    }
+
+    /**
+     *  @brief  Grows the buffer to fit at least ::n elements, discarding the old contents.
+     *  @return `true` on success, `false` on memory allocation errors.
+     */
+    bool resize(std::size_t n) noexcept {
+        if (n <= size_)
+            return true;
+        element_t* elements = allocator_t{}.allocate(n);
+        if (!elements)
+            return false;
+        reset();
+        elements_ = elements;
+        size_ = n;
+        return true;
+    }
+
+    inline std::size_t size() const noexcept { return size_; }
+    inline element_t* data() noexcept { return elements_; }
+    inline element_t const* data() const noexcept { return elements_; }
+    inline element_t& operator[](std::size_t i) noexcept { return elements_[i]; }
+    inline element_t const& operator[](std::size_t i) const noexcept { return elements_[i]; }
+};
+
+/// @brief Number of neighbors per graph node.
+/// Defaults to 32 in FAISS and 16 in hnswlib.
+/// > It is called `M` in the paper.
+constexpr std::size_t default_connectivity() { return 16; }
+
+/// @brief Hyper-parameter controlling the quality of indexing.
+/// Defaults to 40 in FAISS and 200 in hnswlib.
+/// > It is called `efConstruction` in the paper.
+constexpr std::size_t default_expansion_add() { return 128; }
+
+/// @brief Hyper-parameter controlling the quality of search.
+/// Defaults to 16 in FAISS and 10 in hnswlib.
+/// > It is called `ef` in the paper.
+constexpr std::size_t default_expansion_search() { return 64; }
+
+/// @brief How many not-yet-visited neighbors to prefetch, before
+/// evaluating the distances to them. Roughly matches the number of
+/// outstanding cache-line fills a modern core can sustain.
+constexpr std::size_t default_prefetch_depth() { return 16; }
+
+/// @brief How many queries `index_gt::search_batch` traverses simultaneously
+/// on a single thread. Enough to cover a DRAM round-trip with distance
+/// computations of other queries, without spilling their state out of L1.
+constexpr std::size_t default_interleave() { return 8; }
+
+constexpr std::size_t default_allocator_entry_bytes() { return 64; }
+
+/**
+ *  @brief  The "magic" sequence helps infer the type of the file.
+ *          USearch indexes start with the "usearch" string.
+ */
+constexpr char const* default_magic() { return "usearch"; }
+
+/**
+ *  @brief  Hints for the operating system on how to back the memory arenas and the viewed files.
+ *          Each of them is best-effort: if the pages can't be obtained or pinned, regular ones are used.
+ */
+struct memory_pages_config_t {
+    /// @brief Requests explicit 2 MB pages with `MAP_HUGETLB`, reserved by the administrator
+    /// in `/proc/sys/vm/nr_hugepages`. Only applies to anonymous arenas.
+    bool huge = false;
+    /// @brief Advises the kernel to back the region with transparent huge pages via `madvise`.
+    bool transparent_huge = false;
+    /// @brief Faults-in all the pages upfront with `MAP_POPULATE`, instead of on first access.
+    bool populate = false;
+    /// @brief Pins the pages in RAM with `mlock`, subject to `RLIMIT_MEMLOCK`.
+    bool lock = false;
+    /// @brief Spreads the pages of anonymous arenas round-robin across all the allowed NUMA nodes,
+    /// so that the graph traversals from every socket see the same average latency. Linux-only.
+    bool interleave = false;
+};
+
+/**
+ *  @brief  Pages, that were actually obtained from the operating system for a memory region.
+ *          Transparent huge pages are promoted in the background, so those aren't reflected here.
+ */
+struct memory_pages_stats_t {
+    std::size_t page_bytes = 0;
+    bool locked = false;
+    /// @brief Number of NUMA nodes, the pages are interleaved across, or zero if not interleaved.
+    std::size_t interleaved_nodes = 0;
+};
+
+constexpr std::size_t default_huge_page_bytes() { return 2 * 1024 * 1024; }
+
+inline std::size_t default_page_bytes() noexcept {
+#if defined(USEARCH_DEFINED_WINDOWS)
+    SYSTEM_INFO system_info;
+    ::GetSystemInfo(&system_info);
+    return system_info.dwPageSize;
+#else
+    return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+}
+
+/**
+ *  @brief  Applies the hints, that don't affect the mapping itself, to an already mapped region.
+ */
+inline void advise_memory_pages(void* begin, std::size_t length, memory_pages_config_t config,
+                                memory_pages_stats_t& stats) noexcept {
+#if defined(USEARCH_DEFINED_WINDOWS)
+    stats.locked = config.lock && ::VirtualLock(begin, length);
+#else
+#if defined(MADV_HUGEPAGE)
+    if (config.transparent_huge && stats.page_bytes < default_huge_page_bytes())
+        madvise(begin, length, MADV_HUGEPAGE);
+#endif
+    stats.locked = config.lock && mlock(begin, length) == 0;
+#endif
+}
+
+/**
+ *  @brief  Binds the not yet faulted-in pages of a region to all the NUMA nodes, the process
+ *          is allowed to use, in round-robin order. Doesn't depend on `libnuma`.
+ *  @return Number of nodes, the region is interleaved across, or zero if there is just one.
+ */
+inline std::size_t interleave_memory_pages(void* begin, std::size_t length) noexcept {
+#if defined(USEARCH_DEFINED_LINUX) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+    constexpr int interleave_mode_k = 3;                  // `MPOL_INTERLEAVE`
+    constexpr unsigned long mems_allowed_flag_k = 1 << 2; // `MPOL_F_MEMS_ALLOWED`
+    constexpr std::size_t bits_per_word_k = sizeof(unsigned long) * CHAR_BIT;
+    unsigned long nodes[1024 / bits_per_word_k] = {0};
+    unsigned long max_node = sizeof(nodes) * CHAR_BIT;
+    int mode = 0;
+    if (syscall(SYS_get_mempolicy, &mode, nodes, max_node, nullptr, mems_allowed_flag_k) != 0)
+        return 0;
+    std::size_t count = 0;
+    for (unsigned long word : nodes)
+        count += std::bitset<bits_per_word_k>(word).count();
+    if (count < 2 || syscall(SYS_mbind, begin, length, interleave_mode_k, nodes, max_node + 1, 0) != 0)
+        return 0;
+    return count;
+#else
+    (void)begin, (void)length;
+    return 0;
+#endif
+}
+
+/**
+ *  @brief  Maps an anonymous read-write region, trying explicit huge pages first, if requested.
+ *  @return The region or `nullptr`, if even the regular pages are not available.
+ */
+inline byte_t* map_memory_pages(std::size_t length, memory_pages_config_t config,
+                                memory_pages_stats_t& stats) noexcept {
+#if defined(USEARCH_DEFINED_WINDOWS)
+    byte_t* begin = (byte_t*)(::VirtualAlloc(NULL, length, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
+    if (!begin)
+        return nullptr;
+    stats.page_bytes = default_page_bytes();
+#else
+    // The NUMA policy only affects the pages faulted-in after it is set, so it precedes the population
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#if defined(MAP_POPULATE)
+    if (config.populate && !config.interleave)
+        flags |= MAP_POPULATE;
+#endif
+    void* begin = MAP_FAILED;
+#if defined(MAP_HUGETLB) && defined(MAP_HUGE_SHIFT)
+    if (config.huge && length % default_huge_page_bytes() == 0) {
+        begin = mmap(NULL, length, PROT_WRITE | PROT_READ, flags | MAP_HUGETLB | (21 << MAP_HUGE_SHIFT), -1, 0);
+        if (begin != MAP_FAILED)
+            stats.page_bytes = default_huge_page_bytes();
+    }
+#endif
+    if (begin == MAP_FAILED) {
+        begin = mmap(NULL, length, PROT_WRITE | PROT_READ, flags, -1, 0);
+        if (begin == MAP_FAILED)
+            return nullptr;
+        stats.page_bytes = default_page_bytes();
+    }
+    if (config.interleave)
+        stats.interleaved_nodes = interleave_memory_pages(begin, length);
+    if (config.populate && config.interleave)
+        for (std::size_t offset = 0; offset < length; offset += stats.page_bytes)
+            static_cast<byte_t*>(begin)[offset] = 0;
+#endif
+    advise_memory_pages(begin, length, config, stats);
+    return (byte_t*)begin;
+}
+
+/**
+ *  @brief  Configuration settings for the index construction.
+ *          Includes the main `::connectivity` parameter (`M` in the paper)
+ *          and two expansion factors - for construction and search.
+ */
+struct index_config_t {
+    /// @brief Number of neighbors per graph node.
+    /// Defaults to 32 in FAISS and 16 in hnswlib.
     /// > It is called `M` in the paper.
     std::size_t connectivity = default_connectivity();
 
@@ -1227,6 +1908,25 @@ struct index_config_t {
     /// to align to SIMD register size for higher performance with
     /// less split-loads.
     std::size_t vector_alignment = 1;
+
+    /// @brief Stores the distances to neighbors next to their IDs, so that the insertions
+    /// don't recompute them, when pruning saturated lists. Costs extra memory per edge.
+    /// The distances to the vectors, that `update` has replaced, are re-measured instead.
+    bool cache_distances = false;
+
+    /// @brief Page sizes and pinning for the memory-mapped arenas of nodes and the viewed files.
+    memory_pages_config_t pages{};
+
+    /// @brief Keeps the vectors outside of the graph nodes, in one id-indexed array of slots,
+    /// each fitting up to this many scalars and aligned to at least 64 bytes, or `::vector_alignment`.
+    /// Exact search and batch distance evaluations then stream through adjacent cache lines.
+    /// Zero disables it, placing every vector right after the neighbors lists of its node.
+    std::size_t contiguous_dimensions = 0;
+
+    /// @brief Saves the base-level neighbors lists sorted and delta-encoded with varints, instead of
+    /// the fixed-capacity arrays, shrinking the files. Viewed indexes decode those on every visit,
+    /// loaded ones expand those back. The gaps between IDs are the smallest after a `reorder`.
+    bool compressed_base = false;
 };
 
 struct index_limits_t {
@@ -1251,6 +1951,10 @@ struct add_config_t {
 
     /// @brief Don't copy the ::vector, if it's persisted elsewhere.
     bool store_vector = true;
+
+    /// @brief Number of neighbors' tapes and vectors to prefetch
+    /// during graph traversal. Zero disables software prefetching.
+    std::size_t prefetch_depth = default_prefetch_depth();
 };
 
 struct search_config_t {
@@ -1264,6 +1968,14 @@ struct search_config_t {
 
     /// @brief Brute-forces exhaustive search over all entries in the index.
     bool exact = false;
+
+    /// @brief Number of neighbors' tapes and vectors to prefetch
+    /// during graph traversal. Zero disables software prefetching.
+    std::size_t prefetch_depth = default_prefetch_depth();
+
+    /// @brief Number of queries to traverse in round-robin in `search_batch`.
+    /// One disables interleaving, falling back to sequential searches.
+    std::size_t interleave = default_interleave();
 };
 
 struct copy_config_t {
@@ -1309,6 +2021,11 @@ struct file_head_t {
     using size_t = std::uint64_t;
     using entry_idx_t = std::uint64_t;
 
+    // Optional features: 1 byte
+    using flags_t = std::uint8_t;
+    static constexpr flags_t cached_distances_k = 1;
+    static constexpr flags_t compressed_base_k = 2;
+
     // Versioning:
     char const* magic;
     misaligned_ref_gt<version_major_t> version_major;
@@ -1330,6 +2047,7 @@ struct file_head_t {
     misaligned_ref_gt<size_t> bytes_for_graphs;
     misaligned_ref_gt<size_t> bytes_for_vectors;
     misaligned_ref_gt<size_t> bytes_checksum;
+    misaligned_ref_gt<flags_t> flags;
 
     file_head_t(byte_t* ptr) noexcept
         : magic((char const*)exchange(ptr, ptr + sizeof(magic_t))),
@@ -1343,7 +2061,8 @@ struct file_head_t {
           bytes_per_id(exchange(ptr, ptr + sizeof(bytes_per_id_t))),
           scalar_kind(exchange(ptr, ptr + sizeof(scalar_kind_t))), size(exchange(ptr, ptr + sizeof(size_t))),
           entry_idx(exchange(ptr, ptr + sizeof(entry_idx_t))), bytes_for_graphs(exchange(ptr, ptr + sizeof(size_t))),
-          bytes_for_vectors(exchange(ptr, ptr + sizeof(size_t))), bytes_checksum(exchange(ptr, ptr + sizeof(size_t))) {}
+          bytes_for_vectors(exchange(ptr, ptr + sizeof(size_t))), bytes_checksum(exchange(ptr, ptr + sizeof(size_t))),
+          flags(exchange(ptr, ptr + sizeof(flags_t))) {}
 };
 
 struct file_head_result_t {
@@ -1360,6 +2079,7 @@ struct file_head_result_t {
     using bytes_per_id_t = file_head_t::bytes_per_id_t;
     using size_t = file_head_t::size_t;
     using entry_idx_t = file_head_t::entry_idx_t;
+    using flags_t = file_head_t::flags_t;
 
     // Versioning:
     version_major_t version_major;
@@ -1381,6 +2101,7 @@ struct file_head_result_t {
     size_t bytes_for_graphs;
     size_t bytes_for_vectors;
     size_t bytes_checksum;
+    flags_t flags;
 
     error_t error;
 
@@ -1409,6 +2130,7 @@ struct viewed_file_t {
     HANDLE mapping_handle{};
     void* ptr{};
     size_t length{};
+    memory_pages_stats_t pages{};
     explicit operator bool() const noexcept { return mapping_handle != nullptr; }
 };
 #else
@@ -1416,6 +2138,7 @@ struct viewed_file_t {
     int file_descriptor{};
     void* ptr{};
     size_t length{};
+    memory_pages_stats_t pages{};
     explicit operator bool() const noexcept { return file_descriptor != 0; }
 };
 #endif
@@ -1451,6 +2174,14 @@ struct dummy_label_to_label_mapping_t {
     template <typename label_at> member_ref_t operator[](label_at&&) const noexcept { return {}; }
 };
 
+struct dummy_relocation_t {
+    template <typename id_at> inline void operator()(id_at /*old_id*/, id_at /*new_id*/) const noexcept {}
+};
+
+struct dummy_reservation_t {
+    template <typename id_at> inline void operator()(id_at /*id*/) const noexcept {}
+};
+
 template <typename, typename at> struct has_reset_gt {
     static_assert(std::integral_constant<at, false>::value, "Second template parameter needs to be of function type.");
 };
@@ -1474,6 +2205,43 @@ struct has_reset_gt<check_at, return_at(args_at...)> {
  */
 template <typename at> constexpr bool has_reset() { return has_reset_gt<at, void()>::value; }
 
+/**
+ *  @brief  Checks if a certain metric can evaluate the distances from one query to
+ *          many candidates in a single call, exposing a member function called `batch`.
+ */
+template <typename metric_at, typename view_at, typename result_at> struct has_batch_gt {
+  private:
+    template <typename at>
+    static constexpr auto check(at*) -> decltype(std::declval<at const&>().batch( //
+                                                     std::declval<view_at>(), std::declval<view_at const*>(),
+                                                     std::declval<std::size_t>(), std::declval<result_at*>()),
+                                                 std::true_type{});
+    template <typename> static constexpr std::false_type check(...);
+
+    typedef decltype(check<metric_at>(0)) type;
+
+  public:
+    static constexpr bool value = type::value;
+};
+
+/**
+ *  @brief  Checks if a certain allocator can serve every thread from a separate arena,
+ *          exposing a member function `allocate`, that takes the thread index after the size.
+ */
+template <typename allocator_at> struct has_thread_allocate_gt {
+  private:
+    template <typename at>
+    static constexpr auto check(at*)
+        -> decltype(std::declval<at&>().allocate(std::declval<std::size_t>(), std::declval<std::size_t>()),
+                    std::true_type{});
+    template <typename> static constexpr std::false_type check(...);
+
+    typedef decltype(check<allocator_at>(0)) type;
+
+  public:
+    static constexpr bool value = type::value;
+};
+
 /**
  *  @brief  Approximate Nearest Neighbors Search index using the
  *          Hierarchical Navigable Small World @b (HNSW) graphs algorithm.
@@ -1662,6 +2430,7 @@ class index_gt {
      *          the base level be compared to other levels.
      */
     static constexpr std::size_t base_level_multiple_() { return 2; }
+    static constexpr std::size_t exact_prefetch_distance_() { return 4; }
 
     /**
      *  @brief  How many bytes of memory are needed to form the "head" of the node.
@@ -1669,12 +2438,21 @@ class index_gt {
     static constexpr std::size_t node_head_bytes_() { return sizeof(label_t) + sizeof(dim_t) + sizeof(level_t); }
 
     using visits_bitset_t = visits_bitset_gt<dynamic_allocator_t>;
+    using visits_set_t = visits_set_gt<dynamic_allocator_t>;
+    using versions_t = versions_gt<dynamic_allocator_t>;
 
     struct precomputed_constants_t {
         double inverse_log_connectivity{};
         std::size_t connectivity_max_base{};
         std::size_t neighbors_bytes{};
         std::size_t neighbors_base_bytes{};
+        std::size_t vector_alignment{};
+        std::size_t vector_stride{};
+    };
+    struct vectors_buffer_t {
+        byte_t* allocation{};
+        byte_t* data{};
+        std::size_t bytes{};
     };
     struct candidate_t {
         distance_t distance;
@@ -1686,6 +2464,9 @@ class index_gt {
 
     using candidates_view_t = span_gt<candidate_t const>;
     using candidates_allocator_t = typename allocator_traits_t::template rebind_alloc<candidate_t>;
+    using ids_allocator_t = typename allocator_traits_t::template rebind_alloc<id_t>;
+    using vectors_allocator_t = typename allocator_traits_t::template rebind_alloc<vector_view_t>;
+    using distances_allocator_t = typename allocator_traits_t::template rebind_alloc<distance_t>;
     using top_candidates_t = sorted_buffer_gt<candidate_t, compare_by_distance_t, candidates_allocator_t>;
     using next_candidates_t = max_heap_gt<candidate_t, compare_by_distance_t, candidates_allocator_t>;
 
@@ -1749,6 +2530,32 @@ class index_gt {
         }
     };
 
+    /**
+     *  @brief  State of a single query traversal in `search_batch`, that can be suspended
+     *          after the neighbors of a node are gathered and prefetched, and resumed once
+     *          the other traversals had their turn, and the data has arrived into caches.
+     */
+    struct search_lane_t {
+        top_candidates_t top{};
+        next_candidates_t next{};
+        visits_set_t visits{};
+
+        /// @brief Gathered and prefetched neighbors, which distances are yet to be evaluated.
+        buffer_gt<id_t, ids_allocator_t> successors_ids{};
+        std::size_t successors_count{};
+
+        vector_view_t query{};
+        std::size_t query_idx{};
+        /// @brief Distance to the `closest_id` on upper levels, and the search radius on the base one.
+        distance_t radius{};
+        id_t closest_id{};
+        level_t level{};
+        bool in_base{};
+        bool active{};
+    };
+
+    using lanes_allocator_t = typename allocator_traits_t::template rebind_alloc<search_lane_t>;
+
     /**
      *  @brief  A package of all kinds of temporary data-structures, that the threads
      *          would reuse to process requests. Similar to having all of those as
@@ -1757,16 +2564,98 @@ class index_gt {
     struct usearch_align_m context_t {
         top_candidates_t top_candidates{};
         next_candidates_t next_candidates{};
-        visits_bitset_t visits{};
+        visits_set_t visits{};
+        /// @brief Unbounded set of matches of `search_range`, sorted only once the traversal is over.
+        next_candidates_t range_candidates{};
         std::default_random_engine level_generator{};
         metric_t metric{};
         std::size_t iteration_cycles{};
         std::size_t measurements_count{};
+        /// @brief Number of `node_lock_` calls and of the backoff rounds, while the lock was held by others.
+        std::size_t lock_acquisitions{};
+        std::size_t lock_spins{};
+
+        /// @brief Unvisited neighbors of the current candidate, evaluated in one batch.
+        buffer_gt<id_t, ids_allocator_t> successors_ids{};
+        buffer_gt<vector_view_t, vectors_allocator_t> successors_vectors{};
+        buffer_gt<distance_t, distances_allocator_t> successors_distances{};
+        /// @brief Base neighbors list of the current candidate, if the viewed file keeps those compressed.
+        buffer_gt<byte_t, dynamic_allocator_t> unpacked_base{};
+        /// @brief Traversals of `search_batch`, kept between the calls to reuse their visited sets.
+        search_lane_t* lanes{};
+        std::size_t lanes_count{};
+        /// @brief Value of `epoch_` when the current traversal has started, or zero between them.
+        std::atomic<std::size_t> epoch{};
+
+        context_t() noexcept {}
+        ~context_t() noexcept { reset_lanes(); }
+        context_t(context_t const&) = delete;
+        context_t& operator=(context_t const&) = delete;
 
         inline distance_t measure(vector_view_t a, vector_view_t b) noexcept {
             measurements_count++;
             return metric(a, b);
         }
+
+        inline void measure_batch(vector_view_t query, std::size_t count) noexcept {
+            measurements_count += count;
+            using batched_t = std::integral_constant<bool, has_batch_gt<metric_t, vector_view_t, distance_t>::value>;
+            measure_batch_(query, count, batched_t{});
+        }
+
+        bool reserve_successors(std::size_t count) noexcept {
+            return successors_ids.resize(count) && successors_vectors.resize(count) &&
+                   successors_distances.resize(count) &&
+                   unpacked_base.resize(sizeof(neighbors_count_t) + count * sizeof(id_t));
+        }
+
+        /**
+         *  @brief  Grows the pool of `search_batch` traversals to at least ::count lanes.
+         *  @return `true` on success, `false` on memory allocation errors.
+         */
+        bool reserve_lanes(std::size_t count) noexcept {
+            if (count <= lanes_count)
+                return true;
+            search_lane_t* new_lanes = lanes_allocator_t{}.allocate(count);
+            if (!new_lanes)
+                return false;
+            reset_lanes();
+            for (std::size_t i = 0; i != count; ++i)
+                new (new_lanes + i) search_lane_t();
+            lanes = new_lanes;
+            lanes_count = count;
+            return true;
+        }
+
+        /// @brief  Memory held by the `search_batch` lanes, that outlive the calls.
+        std::size_t lanes_memory_usage() const noexcept {
+            std::size_t total = lanes_count * sizeof(search_lane_t);
+            for (std::size_t i = 0; i != lanes_count; ++i) {
+                search_lane_t const& lane = lanes[i];
+                total += (lane.top.capacity() + lane.next.capacity()) * sizeof(candidate_t);
+                total += lane.successors_ids.size() * sizeof(id_t);
+                total += lane.visits.memory_usage();
+            }
+            return total;
+        }
+
+        void reset_lanes() noexcept {
+            if (!lanes)
+                return;
+            for (std::size_t i = 0; i != lanes_count; ++i)
+                lanes[i].~search_lane_t();
+            lanes_allocator_t{}.deallocate(exchange(lanes, nullptr), lanes_count);
+            lanes_count = 0;
+        }
+
+      private:
+        inline void measure_batch_(vector_view_t query, std::size_t count, std::true_type) noexcept {
+            metric.batch(query, successors_vectors.data(), count, successors_distances.data());
+        }
+        inline void measure_batch_(vector_view_t query, std::size_t count, std::false_type) noexcept {
+            for (std::size_t i = 0; i != count; ++i)
+                successors_distances[i] = metric(query, successors_vectors[i]);
+        }
     };
 
     index_config_t config_{};
@@ -1776,28 +2665,55 @@ class index_gt {
     tape_allocator_t tape_allocator_{};
     precomputed_constants_t pre_{};
     viewed_file_t viewed_file_{};
+    /// @brief  Id-indexed slots of vectors, if `config_.contiguous_dimensions` is set.
+    vectors_buffer_t vectors_{};
 
     usearch_align_m mutable std::atomic<std::size_t> capacity_{};
     usearch_align_m mutable std::atomic<std::size_t> size_{};
 
-    /// @brief  Controls access to `max_level_` and `entry_id_`.
-    ///         If any thread is updating those values, no other threads can `add()` or `search()`.
-    std::mutex global_mutex_{};
-    level_t max_level_{};
-    id_t entry_id_{};
+    struct entry_point_t {
+        level_t level;
+        id_t id;
+    };
+
+    /// @brief  Identifiers of up to six bytes are packed with the level of the entry point into one word.
+    using entry_packed_t = std::integral_constant<bool, sizeof(id_t) <= 6>;
+
+    /// @brief  The entry point of the graph and its level, packed by `entry_pack_` into one word,
+    ///         so that insertions can promote a new entry point with a single CAS.
+    usearch_align_m std::atomic<std::uint64_t> entry_{entry_pack_({-1, id_t{}})};
+    /// @brief  The entry point for the identifiers too wide to be packed, guarded by the `entry_mutex_`.
+    entry_point_t entry_wide_{-1, id_t{}};
+    mutable std::mutex entry_mutex_;
 
     using nodes_allocator_t = typename allocator_traits_t::template rebind_alloc<node_t>;
     node_t* nodes_{};
     mutable visits_bitset_t nodes_mutexes_{};
+    /// @brief  Sequence counters of the neighbors lists, for lock-free reads on upper levels.
+    versions_t nodes_versions_{};
+    /// @brief  Nodes, whose vectors `update` has replaced, so the distances cached to them may be stale.
+    visits_bitset_t nodes_updated_{};
 
     using contexts_allocator_t = typename allocator_traits_t::template rebind_alloc<context_t>;
     context_t* contexts_{};
 
+    /// @brief  Node replaced by `update`, that can be freed, once no traversal started by ::epoch runs.
+    struct retired_node_t {
+        node_t node;
+        std::size_t epoch;
+    };
+    using retired_allocator_t = typename allocator_traits_t::template rebind_alloc<retired_node_t>;
+    /// @brief  Counter of the node replacements, that the traversals compare against the `retired_nodes_`.
+    usearch_align_m mutable std::atomic<std::size_t> epoch_{1};
+    /// @brief  Nodes waiting for the concurrent traversals to finish, ordered by epochs.
+    ring_gt<retired_node_t, retired_allocator_t> retired_nodes_{};
+    std::mutex retired_mutex_;
+
   public:
     std::size_t connectivity() const noexcept { return config_.connectivity; }
     std::size_t capacity() const noexcept { return capacity_; }
     std::size_t size() const noexcept { return size_; }
-    std::size_t max_level() const noexcept { return static_cast<std::size_t>(max_level_); }
+    std::size_t max_level() const noexcept { return static_cast<std::size_t>(entry_point_().level); }
     index_config_t const& config() const noexcept { return config_; }
     index_limits_t const& limits() const noexcept { return limits_; }
     bool is_immutable() const noexcept { return bool(viewed_file_); }
@@ -1809,13 +2725,13 @@ class index_gt {
     explicit index_gt(index_config_t config = {}, metric_t metric = {}, dynamic_allocator_t allocator = {},
                       tape_allocator_t tape_allocator = {}) noexcept
         : config_(config), limits_(0, 0), metric_(metric), dynamic_allocator_(std::move(allocator)),
-          tape_allocator_(std::move(tape_allocator)), pre_(precompute_(config)), size_(0u), max_level_(-1),
-          entry_id_(0u), nodes_(nullptr), nodes_mutexes_(), contexts_(nullptr) {}
+          tape_allocator_(std::move(tape_allocator)), pre_(precompute_(config)), size_(0u),
+          nodes_(nullptr), nodes_mutexes_(), nodes_versions_(), nodes_updated_(), contexts_(nullptr) {}
 
     /**
      *  @brief  Clones the structure with the same hyper-parameters, but without contents.
      */
-    index_gt fork() noexcept { return index_gt{config_, metric_, dynamic_allocator_}; }
+    index_gt fork() noexcept { return index_gt{config_, metric_, dynamic_allocator_, tape_allocator_}; }
 
     ~index_gt() noexcept { reset(); }
 
@@ -1845,13 +2761,25 @@ class index_gt {
             return result.failed("Failed to reserve the contexts");
 
         // Now all is left - is to allocate new `node_t` instances and populate
-        // the `other.nodes_` array into it.
+        // the `other.nodes_` array into it. The compressed lists of a viewed file are expanded back.
+        for (std::size_t i = 0; i != size_ && !base_packed_(); ++i)
+            other.nodes_[i] = other.node_make_copy_(i, node_bytes_split_(nodes_[i]));
+        for (std::size_t i = 0; i != size_ && base_packed_(); ++i) {
+            node_t node = nodes_[i];
+            node_t copy = other.node_make_(i, node.label(), node.vector_view(), node.level(), true, 0);
+            if (!copy)
+                return result.failed("Out of memory!");
+            std::memcpy(other.neighbors_upper_tape_(copy), neighbors_upper_tape_(node),
+                        pre_.neighbors_bytes * node.level());
+            base_unpack_(base_packed_tape_(node), copy.neighbors_tape(), other.neighbors_distances_(copy, 0));
+            other.nodes_[i] = copy;
+        }
         for (std::size_t i = 0; i != size_; ++i)
-            other.nodes_[i] = other.node_make_copy_(node_bytes_split_(nodes_[i]));
+            if (nodes_updated_.test(i))
+                other.nodes_updated_.set(i);
 
         other.size_ = size_.load();
-        other.max_level_ = max_level_;
-        other.entry_id_ = entry_id_;
+        other.store_entry_point_(entry_point_());
         return result;
     }
 
@@ -1885,11 +2813,15 @@ class index_gt {
             std::size_t n = size_;
             for (std::size_t i = 0; i != n; ++i)
                 node_free_(i);
+            retired_node_t retired;
+            while (retired_nodes_.try_pop(retired))
+                node_free_(retired.node);
         } else
             tape_allocator_.deallocate(nullptr, 0);
+        retired_nodes_.clear();
+        nodes_updated_.clear();
         size_ = 0;
-        max_level_ = -1;
-        entry_id_ = 0u;
+        store_entry_point_({-1, id_t{}});
     }
 
     /**
@@ -1899,6 +2831,9 @@ class index_gt {
      */
     void reset() noexcept {
         clear();
+        vectors_free_(vectors_);
+        retired_nodes_.reset();
+        nodes_updated_.reset();
 
         if (nodes_)
             nodes_allocator_t{}.deallocate(exchange(nodes_, nullptr), limits_.members);
@@ -1923,19 +2858,25 @@ class index_gt {
         std::swap(tape_allocator_, other.tape_allocator_);
         std::swap(pre_, other.pre_);
         std::swap(viewed_file_, other.viewed_file_);
-        std::swap(max_level_, other.max_level_);
-        std::swap(entry_id_, other.entry_id_);
+        std::swap(vectors_, other.vectors_);
         std::swap(nodes_, other.nodes_);
         std::swap(nodes_mutexes_, other.nodes_mutexes_);
+        std::swap(nodes_versions_, other.nodes_versions_);
+        std::swap(nodes_updated_, other.nodes_updated_);
         std::swap(contexts_, other.contexts_);
+        retired_nodes_.swap(other.retired_nodes_);
 
         // Non-atomic parts.
+        entry_point_t entry = entry_point_();
+        store_entry_point_(other.entry_point_());
+        other.store_entry_point_(entry);
         std::size_t capacity_copy = capacity_;
         std::size_t size_copy = size_;
         capacity_ = other.capacity_.load();
         size_ = other.size_.load();
         other.capacity_ = capacity_copy;
         other.size_ = size_copy;
+        epoch_ = other.epoch_.exchange(epoch_.load());
     }
 
     /**
@@ -1951,17 +2892,27 @@ class index_gt {
 
         if (!nodes_mutexes_.resize(limits.members))
             return false;
+        if (!nodes_versions_.resize(limits.members))
+            return false;
+        if (!nodes_updated_.resize(limits.members))
+            return false;
+        vectors_buffer_t new_vectors;
+        if (!vectors_allocate_(limits.members, new_vectors))
+            return false;
 
         nodes_allocator_t node_allocator;
         node_t* new_nodes = node_allocator.allocate(limits.members);
-        if (!new_nodes)
+        if (!new_nodes) {
+            vectors_free_(new_vectors);
             return false;
+        }
 
         std::size_t limits_threads = limits.threads();
         contexts_allocator_t context_allocator;
         context_t* new_contexts = context_allocator.allocate(limits_threads);
         if (!new_contexts) {
             node_allocator.deallocate(new_nodes, limits.members);
+            vectors_free_(new_vectors);
             return false;
         }
         for (std::size_t i = 0; i != limits_threads; ++i) {
@@ -1973,6 +2924,7 @@ class index_gt {
                     context.visits.reset();
                 node_allocator.deallocate(new_nodes, limits.members);
                 context_allocator.deallocate(new_contexts, limits_threads);
+                vectors_free_(new_vectors);
                 return false;
             }
         }
@@ -1984,9 +2936,17 @@ class index_gt {
             context_t& context = new_contexts[i];
             std::swap(old_context.top_candidates, context.top_candidates);
             std::swap(old_context.next_candidates, context.next_candidates);
+            std::swap(old_context.range_candidates, context.range_candidates);
             std::swap(old_context.iteration_cycles, context.iteration_cycles);
             std::swap(old_context.measurements_count, context.measurements_count);
-            old_context.visits.reset();
+            std::swap(old_context.lock_acquisitions, context.lock_acquisitions);
+            std::swap(old_context.lock_spins, context.lock_spins);
+            std::swap(old_context.successors_ids, context.successors_ids);
+            std::swap(old_context.successors_vectors, context.successors_vectors);
+            std::swap(old_context.successors_distances, context.successors_distances);
+            std::swap(old_context.lanes, context.lanes);
+            std::swap(old_context.lanes_count, context.lanes_count);
+            old_context.~context_t();
         }
 
         // Move the nodes info, and deallocate previous buffers.
@@ -1995,6 +2955,17 @@ class index_gt {
         if (contexts_)
             context_allocator.deallocate(contexts_, limits_.threads());
 
+        // Move the vectors into the new slots, unless those were kept outside of the index
+        for (std::size_t i = 0; new_vectors.data && i != size(); ++i) {
+            if (new_nodes[i].vector() != vector_slot_(i))
+                continue;
+            scalar_t* vector = reinterpret_cast<scalar_t*>(new_vectors.data + i * pre_.vector_stride);
+            std::memcpy(vector, new_nodes[i].vector(), node_vector_bytes_(new_nodes[i]));
+            new_nodes[i] = node_t{new_nodes[i].tape(), vector};
+        }
+        vectors_free_(vectors_);
+        vectors_ = new_vectors;
+
         limits_ = limits;
         capacity_ = limits.members;
         nodes_ = new_nodes;
@@ -2024,6 +2995,9 @@ class index_gt {
         std::size_t new_size{};
         std::size_t cycles{};
         std::size_t measurements{};
+        /// @brief Number of node locks taken, and of the backoff rounds spent waiting for them.
+        std::size_t lock_acquisitions{};
+        std::size_t lock_spins{};
         id_t id{};
 
         explicit operator bool() const noexcept { return !error; }
@@ -2041,9 +3015,12 @@ class index_gt {
     class search_result_t {
         index_gt const& index_;
         top_candidates_t& top_;
+        /// @brief  The context of the search, that keeps the found nodes from being freed while those are read.
+        context_t& context_;
 
         friend class index_gt;
-        inline search_result_t(index_gt const& index, top_candidates_t& top) noexcept : index_(index), top_(top) {}
+        inline search_result_t(index_gt const& index, top_candidates_t& top, context_t& context) noexcept
+            : index_(index), top_(top), context_(context) {}
 
       public:
         std::size_t count{};
@@ -2055,7 +3032,7 @@ class index_gt {
         // given that search_result_t can represent a failed result (which implies no valid top_candidates_t &top_),
         // the top_ probably needs to be a pointer.
         inline search_result_t(index_gt const& index) noexcept
-            : index_(index), top_(index.contexts_[0].top_candidates) {}
+            : index_(index), top_(index.contexts_[0].top_candidates), context_(index.contexts_[0]) {}
         inline search_result_t(search_result_t&&) = default;
         inline search_result_t& operator=(search_result_t&&) = default;
 
@@ -2078,12 +3055,14 @@ class index_gt {
             return false;
         }
         inline match_t at(std::size_t i) const noexcept {
+            epoch_guard_t epoch_guard = index_.epoch_enter_(context_);
             candidate_t const* top_ordered = top_.data();
             candidate_t candidate = top_ordered[i];
             node_t node = index_.node_with_id_(candidate.id);
             return {member_cref_t{node.label(), node.vector_view(), candidate.id}, candidate.distance};
         }
         inline std::size_t dump_to(label_t* labels, distance_t* distances) const noexcept {
+            epoch_guard_t epoch_guard = index_.epoch_enter_(context_);
             for (std::size_t i = 0; i != count; ++i) {
                 match_t result = operator[](i);
                 labels[i] = result.member.label;
@@ -2092,12 +3071,27 @@ class index_gt {
             return count;
         }
         inline std::size_t dump_to(label_t* labels) const noexcept {
+            epoch_guard_t epoch_guard = index_.epoch_enter_(context_);
             for (std::size_t i = 0; i != count; ++i) {
                 match_t result = operator[](i);
                 labels[i] = result.member.label;
             }
             return count;
         }
+
+        /**
+         *  @brief  Re-evaluates the distances to all the found members, re-sorts them and keeps
+         *          only the ::wanted closest. Useful to refine matches found with compressed vectors.
+         *  @param[in] rescore Callable receiving a `member_cref_t` and returning the refined distance.
+         */
+        template <typename rescore_at> void rerank(rescore_at&& rescore, std::size_t wanted) noexcept {
+            candidate_t* top_ordered = top_.data();
+            for (std::size_t i = 0; i != count; ++i)
+                top_ordered[i].distance = rescore(at(i).member);
+            std::sort(top_ordered, top_ordered + count, compare_by_distance_t{});
+            count = (std::min)(count, wanted);
+            top_.shrink(count);
+        }
     };
 
     /**
@@ -2106,14 +3100,19 @@ class index_gt {
      *  @param[in] label External identifier/name/descriptor for the vector.
      *  @param[in] vector Contiguous range of scalars forming a vector view.
      *  @param[in] config Configuration options for this specific operation.
+     *  @param[in] reservation Callback receiving the new identifier, before the node is linked into the graph.
      */
-    add_result_t add(label_t label, vector_view_t vector, add_config_t config = {}) usearch_noexcept_m {
+    template <typename reservation_at = dummy_reservation_t>
+    add_result_t add(                                                  //
+        label_t label, vector_view_t vector, add_config_t config = {}, //
+        reservation_at&& reservation = reservation_at{}) usearch_noexcept_m {
 
         usearch_assert_m(!is_immutable(), "Can't add to an immutable index");
         add_result_t result;
 
         // Make sure we have enough local memory to perform this request
         context_t& context = contexts_[config.thread];
+        epoch_guard_t epoch_guard = epoch_enter_(context);
         top_candidates_t& top = context.top_candidates;
         next_candidates_t& next = context.next_candidates;
         top.clear();
@@ -2126,114 +3125,683 @@ class index_gt {
             return result.failed("Out of memory!");
         if (!next.reserve(config.expansion))
             return result.failed("Out of memory!");
+        if (!context.reserve_successors(pre_.connectivity_max_base))
+            return result.failed("Out of memory!");
 
         // Determining how much memory to allocate for the node depends on the target level
-        std::unique_lock<std::mutex> new_level_lock(global_mutex_);
-        level_t max_level_copy = max_level_; // Copy under lock
-        id_t entry_id_copy = entry_id_;      // Copy under lock
         level_t target_level = choose_random_level_(context.level_generator);
-        if (target_level <= max_level_copy)
-            new_level_lock.unlock();
 
-        // Allocate the neighbors
-        node_t node = node_make_(label, vector, target_level, config.store_vector);
+        // Allocate the neighbors, before publishing the node in `size()`.
+        // The contiguous slot of the vector is only known with the identifier.
+        if (!fits_slot_(vector))
+            return result.failed("Vector doesn't fit into the contiguous storage!");
+        bool in_slot = config.store_vector && config_.contiguous_dimensions;
+        node_t node = node_make_(0, label, vector, target_level, config.store_vector && !in_slot, config.thread);
         if (!node)
             return result.failed("Out of memory!");
         std::size_t old_size = size_.fetch_add(1);
         id_t new_id = static_cast<id_t>(old_size);
+        if (in_slot)
+            node = node_slot_(node, old_size, vector);
         nodes_[old_size] = node;
         result.new_size = old_size + 1;
         result.id = new_id;
-        node_lock_t new_lock = node_lock_(old_size);
-
-        // Do nothing for the first element
-        if (!new_id) {
-            entry_id_ = new_id;
-            max_level_ = target_level;
-            return result;
-        }
 
         // Pull stats
         result.measurements = context.measurements_count;
         result.cycles = context.iteration_cycles;
+        result.lock_acquisitions = context.lock_acquisitions;
+        result.lock_spins = context.lock_spins;
 
-        connect_node_across_levels_(new_id, vector, entry_id_copy, max_level_copy, target_level, config, context);
+        // Searches can only reach the node through the links, so it's still private to this thread
+        reservation(new_id);
+        connect_to_entry_(new_id, vector, target_level, config, context);
 
         // Normalize stats
         result.measurements = context.measurements_count - result.measurements;
         result.cycles = context.iteration_cycles - result.cycles;
-
-        // Updating the entry point if needed
-        if (target_level > max_level_copy) {
-            entry_id_ = new_id;
-            max_level_ = target_level;
-        }
+        result.lock_acquisitions = context.lock_acquisitions - result.lock_acquisitions;
+        result.lock_spins = context.lock_spins - result.lock_spins;
         return result;
     }
 
+    struct add_many_result_t {
+        error_t error{};
+        std::size_t new_size{};
+        std::size_t cycles{};
+        std::size_t measurements{};
+        std::size_t lock_acquisitions{};
+        std::size_t lock_spins{};
+        /// @brief Identifier of the first added member, the others follow in the order of inputs.
+        id_t first_id{};
+
+        explicit operator bool() const noexcept { return !error; }
+        add_many_result_t failed(error_t message) noexcept {
+            error = std::move(message);
+            return std::move(*this);
+        }
+    };
+
     /**
-     *  @brief Update an existing entry, replacing a vector and a label. Thread-safe.
+     *  @brief  Inserts many vectors at once, in parallel. Unlike a loop over `add`, draws all the
+     *          levels upfront and links the members level by level, starting from the highest.
+     *          So the upper levels are complete, before the bulk of base-level insertions fans out.
+     *          Can run concurrently with searches, but not with other insertions or updates.
      *
-     *  @param[in] old_id Existing internal identifier for a node to be replaced.
-     *  @param[in] label External identifier/name/descriptor for the vector.
-     *  @param[in] vector Contiguous range of scalars forming a vector view.
-     *  @param[in] config Configuration options for this specific operation.
+     *  @param[in] labels Random-access container of ::count labels.
+     *  @param[in] vectors Random-access container of ::count `vector_view_t`.
+     *  @param[in] config Configuration options, shared by all insertions. The `thread` is ignored.
+     *  @param[in] executor Thread-pool to execute the job in parallel.
+     *  @param[in] progress Callback to report the execution progress.
      */
-    add_result_t update(id_t old_id, label_t label, vector_view_t vector, add_config_t config = {}) usearch_noexcept_m {
+    template <                                   //
+        typename labels_at,                      //
+        typename vectors_at,                     //
+        typename executor_at = dummy_executor_t, //
+        typename progress_at = dummy_progress_t  //
+        >
+    add_many_result_t add_many(                                      //
+        labels_at&& labels, vectors_at&& vectors, std::size_t count, //
+        add_config_t config = {},                                    //
+        executor_at&& executor = executor_at{},                      //
+        progress_at&& progress = progress_at{}) usearch_noexcept_m {
 
         usearch_assert_m(!is_immutable(), "Can't add to an immutable index");
-        add_result_t result;
+        add_many_result_t result;
+        result.new_size = size();
+        result.first_id = static_cast<id_t>(size());
+        if (!count)
+            return result;
+        if (size() + count > limits_.members)
+            return result.failed("Reserve capacity ahead of insertions!");
+        if (executor.size() > limits_.threads())
+            return result.failed("Executor has more threads than the index has contexts!");
+        for (std::size_t i = 0; config_.contiguous_dimensions && i != count; ++i)
+            if (!fits_slot_(vectors[i]))
+                return result.failed("Vector doesn't fit into the contiguous storage!");
+
+        // Make sure every thread has enough local memory, same as in `add`
+        std::size_t top_limit = (std::max)(base_level_multiple_() * config_.connectivity + 1, config.expansion);
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            context_t& context = contexts_[thread_idx];
+            if (!context.top_candidates.reserve(top_limit) || !context.next_candidates.reserve(config.expansion) ||
+                !context.reserve_successors(pre_.connectivity_max_base))
+                return result.failed("Out of memory!");
+        }
 
-        // Make sure we have enough local memory to perform this request
-        context_t& context = contexts_[config.thread];
-        top_candidates_t& top = context.top_candidates;
-        next_candidates_t& next = context.next_candidates;
-        top.clear();
-        next.clear();
+        // Draw all the levels upfront and bucket the members by level, the highest first.
+        // The counting sort keeps the order of inputs within every bucket.
+        buffer_gt<level_t> levels;
+        buffer_gt<std::size_t> order;
+        if (!levels.resize(count) || !order.resize(count))
+            return result.failed("Out of memory!");
+        level_t top_level = 0;
+        for (std::size_t i = 0; i != count; ++i) {
+            levels[i] = choose_random_level_(contexts_[0].level_generator);
+            top_level = (std::max)(top_level, levels[i]);
+        }
 
-        // The top list needs one more slot than the connectivity of the base level
-        // for the heuristic, that tries to squeeze one more element into saturated list.
-        std::size_t top_limit = (std::max)(base_level_multiple_() * config_.connectivity + 1, config.expansion);
-        if (!top.reserve(top_limit))
+        std::size_t buckets = static_cast<std::size_t>(top_level) + 1;
+        buffer_gt<std::size_t> offsets;
+        if (!offsets.resize(buckets + 1))
             return result.failed("Out of memory!");
-        if (!next.reserve(config.expansion))
+        std::fill(offsets.data(), offsets.data() + buckets + 1, std::size_t(0));
+        for (std::size_t i = 0; i != count; ++i)
+            ++offsets[top_level - levels[i] + 1];
+        for (std::size_t bucket = 1; bucket != buckets + 1; ++bucket)
+            offsets[bucket] += offsets[bucket - 1];
+        for (std::size_t i = 0; i != count; ++i)
+            order[offsets[top_level - levels[i]]++] = i;
+        // Every offset now points to the end of its bucket, so shift them back
+        for (std::size_t bucket = buckets; bucket != 0; --bucket)
+            offsets[bucket] = offsets[bucket - 1];
+        offsets[0] = 0;
+
+        // Allocate all the nodes, so that the identifiers follow the order of inputs.
+        // Those are published in `size()` only once all the allocations have succeeded.
+        std::size_t old_size = size();
+        std::atomic<bool> out_of_memory{false};
+        executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t i) {
+            node_t node = node_make_(old_size + i, labels[i], vectors[i], levels[i], config.store_vector, thread_idx);
+            nodes_[old_size + i] = node;
+            if (!node)
+                out_of_memory = true;
+        });
+        if (out_of_memory) {
+            nodes_release_(old_size, count);
             return result.failed("Out of memory!");
-
-        node_lock_t new_lock = node_lock_(old_id);
-        node_t node = node_with_id_(old_id);
+        }
+        size_ = old_size + count;
+        result.first_id = static_cast<id_t>(old_size);
+        result.new_size = old_size + count;
 
         // Pull stats
-        result.measurements = context.measurements_count;
-        result.cycles = context.iteration_cycles;
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            result.measurements += contexts_[thread_idx].measurements_count;
+            result.cycles += contexts_[thread_idx].iteration_cycles;
+            result.lock_acquisitions += contexts_[thread_idx].lock_acquisitions;
+            result.lock_spins += contexts_[thread_idx].lock_spins;
+        }
 
-        connect_node_across_levels_(old_id, vector, entry_id_, max_level_, node.level(), config, context);
-        node.label(label);
+        // Link the buckets one after another, handing out small chunks of each to the threads
+        std::atomic<std::size_t> passed{0};
+        for (std::size_t bucket = 0; bucket != buckets; ++bucket) {
+            std::size_t const bucket_end = offsets[bucket + 1];
+            std::size_t const bucket_size = bucket_end - offsets[bucket];
+            std::size_t const chunk = (std::min)(std::size_t(64), divide_round_up(bucket_size, executor.size() * 16));
+            std::atomic<std::size_t> cursor{offsets[bucket]};
+
+            executor.execute_bulk([&](std::size_t thread_idx) {
+                context_t& context = contexts_[thread_idx];
+                add_config_t thread_config = config;
+                thread_config.thread = thread_idx;
+                for (std::size_t begin = cursor.fetch_add(chunk); begin < bucket_end; begin = cursor.fetch_add(chunk)) {
+                    std::size_t end = (std::min)(begin + chunk, bucket_end);
+                    for (std::size_t j = begin; j != end; ++j) {
+                        std::size_t i = order[j];
+                        connect_to_entry_(static_cast<id_t>(old_size + i), vectors[i], levels[i], thread_config,
+                                          context);
+                    }
+                    progress(passed += end - begin, count);
+                }
+            });
+        }
 
         // Normalize stats
-        result.measurements = context.measurements_count - result.measurements;
-        result.cycles = context.iteration_cycles - result.cycles;
-
+        std::size_t measurements = 0, cycles = 0, lock_acquisitions = 0, lock_spins = 0;
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            measurements += contexts_[thread_idx].measurements_count;
+            cycles += contexts_[thread_idx].iteration_cycles;
+            lock_acquisitions += contexts_[thread_idx].lock_acquisitions;
+            lock_spins += contexts_[thread_idx].lock_spins;
+        }
+        result.measurements = measurements - result.measurements;
+        result.cycles = cycles - result.cycles;
+        result.lock_acquisitions = lock_acquisitions - result.lock_acquisitions;
+        result.lock_spins = lock_spins - result.lock_spins;
         return result;
     }
 
     /**
-     *  @brief Searches for the closest elements to the given ::query. Thread-safe.
+     *  @brief  Builds the index from a precomputed kNN graph, like the exact ground-truth of a dataset,
+     *          or the output of NN-Descent, instead of searching for the neighbors of every insertion.
+     *          The base-level lists are pruned from the given rows with the same heuristic as `add`,
+     *          and are then complemented with the reverse links. Only the few members, that reach the
+     *          upper levels, are inserted with a search, as they would be in `add_many`.
      *
-     *  @param[in] query Contiguous range of scalars forming a vector view.
-     *  @param[in] wanted The upper bound for the number of results to return.
-     *  @param[in] config Configuration options for this specific operation.
-     *  @param[in] predicate Optional filtering predicate for `member_cref_t`.
-     *  @return Smart object referencing temporary memory. Valid until next `search()` or `add()`.
+     *  @param[in] labels Random-access container of ::count labels.
+     *  @param[in] vectors Random-access container of ::count `vector_view_t`.
+     *  @param[in] neighbors Random-access container of `count * neighbors_per_row` offsets of inputs,
+     *                       row-major. Out-of-range entries, like `-1` padding, and self-loops are skipped.
+     *  @param[in] config Configuration options, shared by all insertions. The `thread` is ignored.
+     *  @param[in] executor Thread-pool to execute the job in parallel.
+     *  @param[in] progress Callback to report the execution progress.
      */
-    template <typename predicate_at = dummy_predicate_t>
-    search_result_t search( //
-        vector_view_t query, std::size_t wanted, search_config_t config = {},
-        predicate_at&& predicate = dummy_predicate_t{}) const noexcept {
+    template <                                   //
+        typename labels_at,                      //
+        typename vectors_at,                     //
+        typename neighbors_at,                   //
+        typename executor_at = dummy_executor_t, //
+        typename progress_at = dummy_progress_t  //
+        >
+    add_many_result_t build_from_graph(                              //
+        labels_at&& labels, vectors_at&& vectors, std::size_t count, //
+        neighbors_at&& neighbors, std::size_t neighbors_per_row,     //
+        add_config_t config = {},                                    //
+        executor_at&& executor = executor_at{},                      //
+        progress_at&& progress = progress_at{}) usearch_noexcept_m {
 
-        context_t& context = contexts_[config.thread];
-        top_candidates_t& top = context.top_candidates;
-        search_result_t result{*this, top};
-        if (!size_)
+        usearch_assert_m(!is_immutable(), "Can't add to an immutable index");
+        add_many_result_t result;
+        if (size())
+            return result.failed("Can only build an empty index from a graph!");
+        if (!count)
+            return result;
+        if (count > limits_.members)
+            return result.failed("Reserve capacity ahead of insertions!");
+        if (executor.size() > limits_.threads())
+            return result.failed("Executor has more threads than the index has contexts!");
+        for (std::size_t i = 0; config_.contiguous_dimensions && i != count; ++i)
+            if (!fits_slot_(vectors[i]))
+                return result.failed("Vector doesn't fit into the contiguous storage!");
+
+        // Every row is measured at once, so the successors buffers must fit it, besides the `add` needs
+        std::size_t const row_limit = (std::max)(pre_.connectivity_max_base, neighbors_per_row);
+        std::size_t const top_limit = (std::max)(base_level_multiple_() * config_.connectivity + 1, config.expansion);
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            context_t& context = contexts_[thread_idx];
+            if (!context.top_candidates.reserve((std::max)(top_limit, row_limit)) ||
+                !context.next_candidates.reserve(config.expansion) || !context.reserve_successors(row_limit))
+                return result.failed("Out of memory!");
+        }
+
+        // Draw the levels and allocate all the nodes, so that the identifiers follow the order of inputs
+        buffer_gt<level_t> levels;
+        buffer_gt<candidate_t> old_neighbors;
+        if (!levels.resize(count) || !old_neighbors.resize(executor.size() * pre_.connectivity_max_base))
+            return result.failed("Out of memory!");
+        for (std::size_t i = 0; i != count; ++i)
+            levels[i] = choose_random_level_(contexts_[0].level_generator);
+
+        // The nodes are published in `size()` only once all the allocations have succeeded
+        std::atomic<bool> out_of_memory{false};
+        executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t i) {
+            node_t node = node_make_(i, labels[i], vectors[i], levels[i], config.store_vector, thread_idx);
+            nodes_[i] = node;
+            if (!node)
+                out_of_memory = true;
+        });
+        if (out_of_memory) {
+            nodes_release_(0, count);
+            return result.failed("Out of memory!");
+        }
+        size_ = count;
+        result.new_size = count;
+
+        // Pull stats
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            result.measurements += contexts_[thread_idx].measurements_count;
+            result.cycles += contexts_[thread_idx].iteration_cycles;
+            result.lock_acquisitions += contexts_[thread_idx].lock_acquisitions;
+            result.lock_spins += contexts_[thread_idx].lock_spins;
+        }
+
+        // Select the outgoing base-level links of every node among its precomputed neighbors
+        std::atomic<std::size_t> passed{0};
+        executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t i) {
+            context_t& context = contexts_[thread_idx];
+            visits_set_t& visits = context.visits;
+            visits.clear();
+            std::size_t successors_count = 0;
+            for (std::size_t j = 0; j != neighbors_per_row; ++j) {
+                std::size_t neighbor_idx = static_cast<std::size_t>(neighbors[i * neighbors_per_row + j]);
+                if (neighbor_idx >= count || neighbor_idx == i)
+                    continue;
+                id_t neighbor_id = static_cast<id_t>(neighbor_idx);
+                if (visits.test(neighbor_id))
+                    continue;
+                if (!visits.set(neighbor_id)) {
+                    out_of_memory = true;
+                    return;
+                }
+                context.successors_ids[successors_count] = neighbor_id;
+                context.successors_vectors[successors_count] = node_with_id_(neighbor_id).vector_view();
+                ++successors_count;
+            }
+            connect_precomputed_(static_cast<id_t>(i), successors_count, context);
+            progress(++passed, count * 2);
+        });
+        if (out_of_memory)
+            return result.failed("Out of memory!");
+
+        // Add the reverse links, that the heuristic will keep, copying every list first,
+        // so that only one node is locked at a time.
+        executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t i) {
+            context_t& context = contexts_[thread_idx];
+            candidate_t* thread_neighbors = old_neighbors.data() + thread_idx * pre_.connectivity_max_base;
+            id_t id = static_cast<id_t>(i);
+            node_t node = node_with_id_(id);
+            std::size_t old_count = 0;
+            {
+                node_lock_t lock = node_lock_(id, context);
+                neighbors_ref_t node_neighbors = neighbors_(node, 0);
+                byte_t* distances = neighbors_distances_(node, 0);
+                for (; old_count != node_neighbors.size(); ++old_count)
+                    thread_neighbors[old_count] = {
+                        distances ? neighbor_distance_(distances, old_count) : distance_t{}, node_neighbors[old_count]};
+            }
+            for (std::size_t idx = 0; idx != old_count; ++idx)
+                link_back_(id, thread_neighbors[idx].id, thread_neighbors[idx].distance, 0, context);
+            progress(++passed, count * 2);
+        });
+
+        // The upper levels are sparse, so those are constructed with searches, the highest members first
+        std::size_t upper_count = 0;
+        buffer_gt<std::size_t> order;
+        if (!order.resize(count))
+            return result.failed("Out of memory!");
+        for (std::size_t i = 0; i != count; ++i)
+            if (levels[i])
+                order[upper_count++] = i;
+        std::stable_sort(order.data(), order.data() + upper_count,
+                         [&](std::size_t a, std::size_t b) { return levels[a] > levels[b]; });
+        for (std::size_t begin = 0, end = 0; begin != upper_count; begin = end) {
+            for (end = begin; end != upper_count && levels[order[end]] == levels[order[begin]];)
+                ++end;
+            executor.execute_bulk(end - begin, [&](std::size_t thread_idx, std::size_t j) {
+                std::size_t i = order[begin + j];
+                add_config_t thread_config = config;
+                thread_config.thread = thread_idx;
+                connect_to_entry_(static_cast<id_t>(i), vectors[i], levels[i], thread_config, contexts_[thread_idx],
+                                  1);
+            });
+        }
+        if (entry_point_().level < 0)
+            promote_entry_point_({0, 0});
+
+        // Normalize stats
+        std::size_t measurements = 0, cycles = 0, lock_acquisitions = 0, lock_spins = 0;
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            measurements += contexts_[thread_idx].measurements_count;
+            cycles += contexts_[thread_idx].iteration_cycles;
+            lock_acquisitions += contexts_[thread_idx].lock_acquisitions;
+            lock_spins += contexts_[thread_idx].lock_spins;
+        }
+        result.measurements = measurements - result.measurements;
+        result.cycles = cycles - result.cycles;
+        result.lock_acquisitions = lock_acquisitions - result.lock_acquisitions;
+        result.lock_spins = lock_spins - result.lock_spins;
+        return result;
+    }
+
+    /**
+     *  @brief  Appends all the members of another index with the same connectivity, reusing its edges,
+     *          instead of re-inserting every vector. The nodes are copied with their neighbors lists,
+     *          remapping the identifiers, and then every incoming node is searched for in this graph,
+     *          to re-select its neighbors among its old ones and the found candidates. Only the cross
+     *          edges into this graph get the reverse links, the rest of the donor graph stays intact.
+     *          Can run concurrently with searches, but not with other insertions or updates.
+     *
+     *  @param[in] other Donor index. All its vectors are copied, so it doesn't have to outlive this one.
+     *  @param[in] config Configuration options for the searches of cross edges. The `thread` is ignored.
+     *  @param[in] executor Thread-pool to execute the job in parallel.
+     *  @param[in] progress Callback to report the execution progress.
+     */
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t>
+    add_many_result_t merge(                    //
+        index_gt const& other,                  //
+        add_config_t config = {},               //
+        executor_at&& executor = executor_at{}, //
+        progress_at&& progress = progress_at{}) usearch_noexcept_m {
+
+        usearch_assert_m(!is_immutable(), "Can't add to an immutable index");
+        add_many_result_t result;
+        std::size_t const count = other.size();
+        result.new_size = size();
+        result.first_id = static_cast<id_t>(size());
+        if (&other == this)
+            return result.failed("Can't merge an index into itself!");
+        if (other.config_.connectivity != config_.connectivity)
+            return result.failed("Can only merge indexes with the same connectivity!");
+        if (other.base_packed_())
+            return result.failed("Can't merge from compressed neighbors lists, load the index first!");
+        if (!count)
+            return result;
+        if (size() + count > limits_.members)
+            return result.failed("Reserve capacity ahead of insertions!");
+        if (executor.size() > limits_.threads())
+            return result.failed("Executor has more threads than the index has contexts!");
+        for (std::size_t i = 0; config_.contiguous_dimensions && i != count; ++i)
+            if (!fits_slot_(other.node_with_id_(i).vector_view()))
+                return result.failed("Vector doesn't fit into the contiguous storage!");
+
+        // The candidates found by the search are pooled with the current edges of the node
+        std::size_t const top_limit = (std::max)(base_level_multiple_() * config_.connectivity + 1, config.expansion);
+        buffer_gt<candidate_t> old_neighbors;
+        if (!old_neighbors.resize(executor.size() * pre_.connectivity_max_base))
+            return result.failed("Out of memory!");
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            context_t& context = contexts_[thread_idx];
+            if (!context.top_candidates.reserve(top_limit + pre_.connectivity_max_base) ||
+                !context.next_candidates.reserve(config.expansion) ||
+                !context.reserve_successors(pre_.connectivity_max_base))
+                return result.failed("Out of memory!");
+        }
+
+        // Pull stats
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            result.measurements += contexts_[thread_idx].measurements_count;
+            result.cycles += contexts_[thread_idx].iteration_cycles;
+            result.lock_acquisitions += contexts_[thread_idx].lock_acquisitions;
+            result.lock_spins += contexts_[thread_idx].lock_spins;
+        }
+
+        // Copy the nodes with their edges, measuring those, if only this index caches the distances,
+        // or if the donor has cached them to the vectors, that it has updated since.
+        // The nodes are published in `size()` only once all the allocations have succeeded.
+        entry_point_t entry = entry_point_();
+        std::size_t const old_size = size();
+        std::atomic<bool> out_of_memory{false};
+        std::atomic<std::size_t> passed{0};
+        executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t i) {
+            context_t& context = contexts_[thread_idx];
+            node_t donor = other.node_with_id_(i);
+            node_t node = node_make_(old_size + i, donor.label(), donor.vector_view(), donor.level(), true, thread_idx);
+            nodes_[old_size + i] = node;
+            if (!node) {
+                out_of_memory = true;
+                return;
+            }
+            for (level_t level = 0; level <= donor.level(); ++level) {
+                neighbors_ref_t donor_neighbors = other.neighbors_(donor, level);
+                byte_t* donor_distances = other.neighbors_distances_(donor, level);
+                neighbors_ref_t neighbors = neighbors_(node, level);
+                byte_t* distances = neighbors_distances_(node, level);
+                for (std::size_t idx = 0; idx != donor_neighbors.size(); ++idx) {
+                    id_t donor_id = donor_neighbors[idx];
+                    distance_t distance =
+                        !distances ? distance_t{}
+                        : donor_distances && !other.nodes_updated_.test(donor_id)
+                            ? neighbor_distance_(donor_distances, idx)
+                            : context.measure(donor, other.node_with_id_(donor_id));
+                    id_t neighbor_id = static_cast<id_t>(old_size + static_cast<std::size_t>(donor_id));
+                    push_neighbor_(neighbors, distances, {distance, neighbor_id});
+                }
+            }
+            progress(++passed, count * 2);
+        });
+        if (out_of_memory) {
+            nodes_release_(old_size, count);
+            return result.failed("Out of memory!");
+        }
+        size_ = old_size + count;
+        result.new_size = old_size + count;
+
+        // Connect the incoming nodes to the ones, that were here before.
+        // If this index was empty, the donor graph is already complete.
+        entry_point_t other_entry = other.entry_point_();
+        if (entry.level >= 0)
+            executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t i) {
+                context_t& context = contexts_[thread_idx];
+                candidate_t* thread_neighbors = old_neighbors.data() + thread_idx * pre_.connectivity_max_base;
+                merge_node_(static_cast<id_t>(old_size + i), old_size, entry, thread_neighbors, config, context);
+                progress(++passed, count * 2);
+            });
+        std::size_t other_entry_id = old_size + static_cast<std::size_t>(other_entry.id);
+        promote_entry_point_({other_entry.level, static_cast<id_t>(other_entry_id)});
+
+        // Normalize stats
+        std::size_t measurements = 0, cycles = 0, lock_acquisitions = 0, lock_spins = 0;
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            measurements += contexts_[thread_idx].measurements_count;
+            cycles += contexts_[thread_idx].iteration_cycles;
+            lock_acquisitions += contexts_[thread_idx].lock_acquisitions;
+            lock_spins += contexts_[thread_idx].lock_spins;
+        }
+        result.measurements = measurements - result.measurements;
+        result.cycles = cycles - result.cycles;
+        result.lock_acquisitions = lock_acquisitions - result.lock_acquisitions;
+        result.lock_spins = lock_spins - result.lock_spins;
+        return result;
+    }
+
+    /**
+     *  @brief  Replaces the contents with the ones of an index with other identifiers, like migrating
+     *          a `uint32_t` index to `uint40_t`, once it outgrows the narrower type. The graph is kept
+     *          as is, only the neighbors lists are re-encoded, which is much cheaper than rebuilding.
+     *
+     *  @param[in] other Index with the same configuration, but different identifiers.
+     *  @param[in] limits Capacity to reserve, that will be raised to fit all the members of the ::other index.
+     */
+    template <typename other_id_at, typename other_dynamic_allocator_at, typename other_tape_allocator_at>
+    add_many_result_t convert(                                                                                   //
+        index_gt<metric_t, label_t, other_id_at, other_dynamic_allocator_at, other_tape_allocator_at> const& other, //
+        index_limits_t limits = {}) noexcept {
+
+        add_many_result_t result;
+        std::size_t const count = other.size();
+        if (!ids_fit_(count))
+            return result.failed("Too many members for the ID type!");
+        if (other.config_.connectivity != config_.connectivity ||
+            other.config_.cache_distances != config_.cache_distances ||
+            other.config_.contiguous_dimensions != config_.contiguous_dimensions)
+            return result.failed("Can only convert indexes with the same configuration!");
+        if (other.base_packed_())
+            return result.failed("Can't convert compressed neighbors lists, load the index first!");
+
+        clear();
+        limits.members = (std::max)(limits.members, count);
+        if (!reserve(limits))
+            return result.failed("Out of memory!");
+
+        for (std::size_t i = 0; i != count; ++i) {
+            auto donor = other.node_with_id_(i);
+            node_t node = node_make_(i, donor.label(), donor.vector_view(), donor.level(), true, 0);
+            if (!node) {
+                size_ = i;
+                return result.failed("Out of memory!");
+            }
+            for (level_t level = 0; level <= donor.level(); ++level) {
+                auto donor_neighbors = other.neighbors_(donor, level);
+                neighbors_ref_t neighbors = neighbors_(node, level);
+                for (std::size_t idx = 0; idx != donor_neighbors.size(); ++idx)
+                    neighbors.push_back(static_cast<id_t>(static_cast<std::size_t>(donor_neighbors[idx])));
+                if (byte_t* distances = neighbors_distances_(node, level))
+                    std::memcpy(distances, other.neighbors_distances_(donor, level),
+                                donor_neighbors.size() * sizeof(distance_t));
+            }
+            nodes_[i] = node;
+            if (other.nodes_updated_.test(i))
+                nodes_updated_.set(i);
+        }
+
+        auto other_entry = other.entry_point_();
+        size_ = count;
+        store_entry_point_({other_entry.level, static_cast<id_t>(static_cast<std::size_t>(other_entry.id))});
+        result.new_size = count;
+        return result;
+    }
+
+    /**
+     *  @brief Update an existing entry, replacing a vector and a label. Thread-safe.
+     *
+     *  The node is rebuilt with a freshly drawn level, as if it was just added, so that repeated
+     *  updates keep the levels distributed. The old node is unlinked from the levels, it no longer
+     *  spans, and its memory is returned to the allocator to be reused by the next nodes, once
+     *  the concurrent `add`, `update` and `search` calls, that may still be reading it, return.
+     *  The results of `search`, that outlive the call, may still reference the replaced vectors.
+     *  If the distances are cached, those of the other nodes to this one are re-measured on use.
+     *
+     *  @param[in] old_id Existing internal identifier for a node to be replaced.
+     *  @param[in] label External identifier/name/descriptor for the vector.
+     *  @param[in] vector Contiguous range of scalars forming a vector view.
+     *  @param[in] config Configuration options for this specific operation.
+     */
+    add_result_t update(id_t old_id, label_t label, vector_view_t vector, add_config_t config = {}) usearch_noexcept_m {
+
+        usearch_assert_m(!is_immutable(), "Can't add to an immutable index");
+        add_result_t result;
+
+        // Make sure we have enough local memory to perform this request
+        context_t& context = contexts_[config.thread];
+        epoch_guard_t epoch_guard = epoch_enter_(context);
+        top_candidates_t& top = context.top_candidates;
+        next_candidates_t& next = context.next_candidates;
+        top.clear();
+        next.clear();
+
+        // The top list needs one more slot than the connectivity of the base level
+        // for the heuristic, that tries to squeeze one more element into saturated list.
+        std::size_t top_limit = (std::max)(base_level_multiple_() * config_.connectivity + 1, config.expansion);
+        if (!top.reserve(top_limit))
+            return result.failed("Out of memory!");
+        if (!next.reserve(config.expansion))
+            return result.failed("Out of memory!");
+        if (!context.reserve_successors(pre_.connectivity_max_base))
+            return result.failed("Out of memory!");
+
+        // The entry point can't sink below the levels, that only it spans
+        level_t target_level = choose_random_level_(context.level_generator);
+        entry_point_t entry = entry_point_();
+        if (entry.id == old_id)
+            target_level = (std::max)(target_level, entry.level);
+
+        if (!fits_slot_(vector))
+            return result.failed("Vector doesn't fit into the contiguous storage!");
+        node_t node = node_make_(old_id, label, vector, target_level, config.store_vector, config.thread);
+        if (!node)
+            return result.failed("Out of memory!");
+        result.new_size = size();
+        result.id = old_id;
+
+        // Pull stats
+        result.measurements = context.measurements_count;
+        result.cycles = context.iteration_cycles;
+        result.lock_acquisitions = context.lock_acquisitions;
+        result.lock_spins = context.lock_spins;
+
+        // The neighbors may have cached the distances to the old vector
+        if (config_.cache_distances)
+            nodes_updated_.atomic_set(old_id);
+
+        // Replacing the entry point, the descent starts from its first neighbor on the highest level
+        node_t old_node;
+        id_t start_id = entry.id;
+        level_t start_level = entry.level;
+        {
+            node_lock_t old_lock = node_lock_(old_id, context);
+            node_write_t old_write = node_write_(old_id);
+            old_node = exchange(nodes_[old_id], node);
+            if (entry.id == old_id) {
+                start_level = -1;
+                for (level_t level = old_node.level(); level >= 0 && start_level < 0; --level)
+                    if (neighbors_(old_node, level).size())
+                        start_id = neighbors_(old_node, level)[0], start_level = level;
+            }
+        }
+
+        // The old neighbors are unlinked before locking the new node, not to hold two locks at once
+        unlink_dropped_levels_(old_id, old_node, target_level, context);
+        {
+            node_lock_t new_lock = node_lock_(old_id, context);
+            if (start_level >= 0)
+                connect_node_across_levels_(old_id, vector, start_id, start_level, target_level, config, context);
+            if (target_level > entry.level)
+                promote_entry_point_({target_level, old_id});
+        }
+
+        // Concurrent traversals may still be reading the old node
+        epoch_guard.leave();
+        node_retire_(old_node);
+
+        // Normalize stats
+        result.measurements = context.measurements_count - result.measurements;
+        result.cycles = context.iteration_cycles - result.cycles;
+        result.lock_acquisitions = context.lock_acquisitions - result.lock_acquisitions;
+        result.lock_spins = context.lock_spins - result.lock_spins;
+
+        return result;
+    }
+
+    /**
+     *  @brief Searches for the closest elements to the given ::query. Thread-safe.
+     *
+     *  @param[in] query Contiguous range of scalars forming a vector view.
+     *  @param[in] wanted The upper bound for the number of results to return.
+     *  @param[in] config Configuration options for this specific operation.
+     *  @param[in] predicate Optional filtering predicate for `member_cref_t`.
+     *  @return Smart object referencing temporary memory. Valid until next `search()` or `add()`.
+     */
+    template <typename predicate_at = dummy_predicate_t>
+    search_result_t search( //
+        vector_view_t query, std::size_t wanted, search_config_t config = {},
+        predicate_at&& predicate = dummy_predicate_t{}) const noexcept {
+
+        context_t& context = contexts_[config.thread];
+        epoch_guard_t epoch_guard = epoch_enter_(context);
+        top_candidates_t& top = context.top_candidates;
+        search_result_t result{*this, top, context};
+        if (!size_)
             return result;
 
         // Go down the level, tracking only the closest match
@@ -2251,10 +3819,14 @@ class index_gt {
                 return result.failed("Out of memory!");
             if (!top.reserve(expansion))
                 return result.failed("Out of memory!");
+            if (!context.reserve_successors(pre_.connectivity_max_base))
+                return result.failed("Out of memory!");
 
-            id_t closest_id = search_for_one_(entry_id_, query, max_level_, 0, context);
+            entry_point_t entry = entry_point_();
+            id_t closest_id = search_for_one_(entry.id, query, entry.level, 0, config.prefetch_depth, context);
             // For bottom layer we need a more optimized procedure
-            if (!search_to_find_in_base_(closest_id, query, expansion, context, std::forward<predicate_at>(predicate)))
+            if (!search_to_find_in_base_(closest_id, query, expansion, config.prefetch_depth, context,
+                                         std::forward<predicate_at>(predicate)))
                 return result.failed("Out of memory!");
         }
 
@@ -2268,6 +3840,180 @@ class index_gt {
         return result;
     }
 
+    /**
+     *  @brief Searches for all the elements within ::max_distance from the given ::query. Thread-safe.
+     *
+     *  Unlike `search()`, doesn't need the number of results upfront. The base-level traversal
+     *  keeps a beam of `config.expansion` closest candidates to navigate towards the query,
+     *  but also expands every node found within the radius, until the whole neighborhood is covered.
+     *
+     *  @param[in] query Contiguous range of scalars forming a vector view.
+     *  @param[in] max_distance The inclusive upper bound for the distance of returned matches.
+     *  @param[in] config Configuration options for this specific operation.
+     *  @param[in] predicate Optional filtering predicate for `member_cref_t`.
+     *  @return Smart object referencing temporary memory. Valid until next `search()` or `add()`.
+     */
+    template <typename predicate_at = dummy_predicate_t>
+    search_result_t search_range( //
+        vector_view_t query, distance_t max_distance, search_config_t config = {},
+        predicate_at&& predicate = dummy_predicate_t{}) const noexcept {
+
+        context_t& context = contexts_[config.thread];
+        epoch_guard_t epoch_guard = epoch_enter_(context);
+        top_candidates_t& top = context.top_candidates;
+        next_candidates_t& matches = context.range_candidates;
+        search_result_t result{*this, top, context};
+        top.clear();
+        matches.clear();
+        if (!size_)
+            return result;
+
+        result.measurements = context.measurements_count;
+        result.cycles = context.iteration_cycles;
+
+        if (config.exact) {
+            if (!search_range_exact_(query, max_distance, context, std::forward<predicate_at>(predicate)))
+                return result.failed("Out of memory!");
+        } else {
+            next_candidates_t& next = context.next_candidates;
+            if (!next.reserve(config.expansion))
+                return result.failed("Out of memory!");
+            if (!top.reserve(config.expansion))
+                return result.failed("Out of memory!");
+            if (!context.reserve_successors(pre_.connectivity_max_base))
+                return result.failed("Out of memory!");
+
+            entry_point_t entry = entry_point_();
+            id_t closest_id = search_for_one_(entry.id, query, entry.level, 0, config.prefetch_depth, context);
+            if (!search_to_find_in_range_(closest_id, query, max_distance, config.expansion, config.prefetch_depth,
+                                          context, std::forward<predicate_at>(predicate)))
+                return result.failed("Out of memory!");
+        }
+
+        // Replace the beam with the matches, sorting them once, instead of on every insertion.
+        top.clear();
+        if (!top.reserve(matches.size()))
+            return result.failed("Out of memory!");
+        matches.sort_ascending();
+        for (std::size_t i = 0; i != matches.size(); ++i)
+            top.insert_reserved(candidate_t{matches.data()[i]});
+
+        // Normalize stats
+        result.measurements = context.measurements_count - result.measurements;
+        result.cycles = context.iteration_cycles - result.cycles;
+        result.count = top.size();
+        return result;
+    }
+
+    struct search_batch_result_t {
+        error_t error{};
+        std::size_t cycles{};
+        std::size_t measurements{};
+
+        explicit operator bool() const noexcept { return !error; }
+        search_batch_result_t failed(error_t message) noexcept {
+            error = std::move(message);
+            return std::move(*this);
+        }
+    };
+
+    /**
+     *  @brief  Searches for the closest elements to every one of the ::queries on a single thread,
+     *          advancing `config.interleave` traversals in round-robin. The neighbors of one query
+     *          are prefetched, while the distances are computed for the others, hiding the memory
+     *          latency of every hop. Produces the same results as calling `search()` for each query.
+     *
+     *  @param[in] queries Random-access range of `vector_view_t`, like a pointer or a functor.
+     *  @param[in] queries_count Number of queries to process.
+     *  @param[in] wanted The upper bound for the number of results per query.
+     *  @param[in] callback Receives the query index and the `search_result_t`, valid only during the call.
+     *  @param[in] config Configuration options for this specific operation.
+     *  @param[in] predicate Optional filtering predicate for `member_cref_t`.
+     */
+    template <typename queries_at, typename callback_at, typename predicate_at = dummy_predicate_t>
+    search_batch_result_t search_batch(                                      //
+        queries_at&& queries, std::size_t queries_count, std::size_t wanted, //
+        callback_at&& callback, search_config_t config = {},                 //
+        predicate_at&& predicate = dummy_predicate_t{}) const noexcept {
+
+        context_t& context = contexts_[config.thread];
+        epoch_guard_t epoch_guard = epoch_enter_(context);
+        search_batch_result_t result;
+        result.measurements = context.measurements_count;
+        result.cycles = context.iteration_cycles;
+
+        // Exhaustive search has no memory stalls to hide, and a single lane has nothing to interleave with.
+        std::size_t const lanes_count = (std::min)(config.interleave, queries_count);
+        if (config.exact || lanes_count <= 1 || !size_) {
+            for (std::size_t query_idx = 0; query_idx != queries_count; ++query_idx) {
+                search_result_t query_result = search(queries[query_idx], wanted, config, predicate);
+                if (!query_result)
+                    return result.failed(std::move(query_result.error));
+                callback(query_idx, query_result);
+            }
+            result.measurements = context.measurements_count - result.measurements;
+            result.cycles = context.iteration_cycles - result.cycles;
+            return result;
+        }
+
+        std::size_t const expansion = (std::max)(config.expansion, wanted);
+        if (!context.reserve_successors(pre_.connectivity_max_base))
+            return result.failed("Out of memory!");
+
+        // The lanes outlive the call, so the visited sets are allocated once per thread, not per batch.
+        if (!context.reserve_lanes(lanes_count))
+            return result.failed("Out of memory!");
+        search_lane_t* lanes = context.lanes;
+        bool out_of_memory = false;
+        for (std::size_t lane_idx = 0; lane_idx != lanes_count; ++lane_idx) {
+            search_lane_t& lane = lanes[lane_idx];
+            lane.active = false;
+            out_of_memory = out_of_memory || !lane.top.reserve(expansion) || !lane.next.reserve(expansion) ||
+                            !lane.visits.resize(limits_.members) ||
+                            !lane.successors_ids.resize(pre_.connectivity_max_base);
+        }
+
+        // Every round resumes each of the lanes: evaluates the neighbors prefetched during
+        // the previous round, and gathers the next ones, prefetching them for the next round.
+        std::size_t next_query_idx = 0;
+        std::size_t active_lanes = 0;
+        while (!out_of_memory && (active_lanes || next_query_idx != queries_count)) {
+            for (std::size_t lane_idx = 0; lane_idx != lanes_count; ++lane_idx) {
+                search_lane_t& lane = lanes[lane_idx];
+                if (lane.active) {
+                    evaluate_lane_(lane, expansion, context, predicate);
+                } else if (next_query_idx != queries_count) {
+                    start_lane_(lane, next_query_idx, queries[next_query_idx], context);
+                    ++next_query_idx;
+                    ++active_lanes;
+                } else
+                    continue;
+
+                if (!advance_lane_(lane, config.prefetch_depth, context)) {
+                    out_of_memory = true;
+                    break;
+                }
+                if (lane.active)
+                    continue;
+
+                lane.top.sort_ascending();
+                lane.top.shrink(wanted);
+                search_result_t query_result{*this, lane.top, context};
+                query_result.count = lane.top.size();
+                callback(lane.query_idx, query_result);
+                --active_lanes;
+            }
+        }
+
+        if (out_of_memory)
+            return result.failed("Out of memory!");
+
+        // Normalize stats
+        result.measurements = context.measurements_count - result.measurements;
+        result.cycles = context.iteration_cycles - result.cycles;
+        return result;
+    }
+
 #pragma endregion
 
 #pragma region Metadata
@@ -2277,17 +4023,35 @@ class index_gt {
         std::size_t edges;
         std::size_t max_edges;
         std::size_t allocated_bytes;
+        /// @brief Node locks taken by all the contexts since construction, and the backoff rounds spent on them.
+        std::size_t lock_acquisitions;
+        std::size_t lock_spins;
+        /// @brief Size of the pages backing the viewed file, and if those are pinned in RAM.
+        /// The index can't see into the tape allocator, so it's zero for the allocated nodes.
+        std::size_t page_bytes;
+        bool pages_locked;
     };
 
+    /**
+     *  @brief  Walks all the nodes and sums the counters of all the thread contexts.
+     *          Neither are synchronized with the writers, so it must not run concurrently
+     *          with `add`, `update`, or `add_many`. Those report their own lock counters.
+     */
     stats_t stats() const noexcept {
         stats_t result{};
         result.nodes = size();
+        result.page_bytes = viewed_file_.pages.page_bytes;
+        result.pages_locked = viewed_file_.pages.locked;
+        for (std::size_t i = 0; contexts_ && i != limits_.threads(); ++i) {
+            result.lock_acquisitions += contexts_[i].lock_acquisitions;
+            result.lock_spins += contexts_[i].lock_spins;
+        }
         for (std::size_t i = 0; i != result.nodes; ++i) {
             node_t node = node_with_id_(i);
             std::size_t max_edges = node.level() * config_.connectivity + base_level_multiple_() * config_.connectivity;
             std::size_t edges = 0;
             for (level_t level = 0; level <= node.level(); ++level)
-                edges += neighbors_(node, level).size();
+                edges += neighbors_count_(node, level);
 
             result.allocated_bytes += node_bytes_(node);
             result.edges += edges;
@@ -2306,7 +4070,7 @@ class index_gt {
             if (static_cast<std::size_t>(node.level()) < level)
                 continue;
 
-            result.edges += neighbors_(node, level).size();
+            result.edges += neighbors_count_(node, static_cast<level_t>(level));
             result.allocated_bytes += node_head_bytes_() + node_vector_bytes_(node) + neighbors_bytes;
         }
 
@@ -2332,6 +4096,9 @@ class index_gt {
 
         // Temporary data-structures, proportional to the number of threads:
         total += limits_.threads() * sizeof(context_t) + allocator_entry_bytes * 3;
+        for (std::size_t i = 0; i != limits_.threads(); ++i)
+            total += contexts_[i].visits.memory_usage() + contexts_[i].lanes_memory_usage();
+        total += nodes_versions_.memory_usage();
         return total;
     }
 
@@ -2365,8 +4132,26 @@ class index_gt {
     template <typename progress_at = dummy_progress_t>
     serialization_result_t save(char const* file_path, progress_at&& progress = {}) const noexcept {
 
-        // Make sure we have right to write to that file
+        // Compressing the base lists needs scratch space for one list at a time
         serialization_result_t result;
+        bool const compress = config_.compressed_base;
+        buffer_gt<candidate_t, candidates_allocator_t> sorted;
+        buffer_gt<byte_t, dynamic_allocator_t> packed;
+        if (compress && (!sorted.resize(pre_.connectivity_max_base) || !packed.resize(base_packed_limit_())))
+            return result.failed("Out of memory!");
+
+        // The distances cached to the updated nodes are re-measured in a copy of the lists
+        buffer_gt<byte_t, dynamic_allocator_t> refreshed;
+        if (config_.cache_distances && !refreshed.resize(node_bytes_(0, (std::max)(entry_point_().level, 0))))
+            return result.failed("Out of memory!");
+        auto pack_base = [&](node_t node, byte_t const*& begin) -> std::size_t {
+            if (base_packed_())
+                return base_unpack_(begin = base_packed_tape_(node), nullptr, nullptr);
+            begin = packed.data();
+            return base_pack_(node, sorted.data(), packed.data());
+        };
+
+        // Make sure we have right to write to that file
         std::FILE* file = std::fopen(file_path, "wb");
         if (!file)
             return result.failed(std::strerror(errno));
@@ -2385,13 +4170,14 @@ class index_gt {
 
         // Describe state
         state.connectivity = config_.connectivity;
-        state.max_level = max_level_;
+        entry_point_t entry = entry_point_();
+        state.max_level = entry.level;
         state.vector_alignment = config_.vector_alignment;
         state.bytes_per_label = sizeof(label_t);
         state.bytes_per_id = sizeof(id_t);
         state.scalar_kind = metric_.scalar_kind();
         state.size = size_;
-        state.entry_idx = entry_id_;
+        state.entry_idx = entry.id;
 
         // Augment with metadata
         std::size_t graphs_bytes = 0;
@@ -2400,12 +4186,16 @@ class index_gt {
             node_t node = node_with_id_(i);
             std::size_t node_bytes = node_bytes_(node);
             std::size_t node_vector_bytes = node_vector_bytes_(node);
-            graphs_bytes += node_bytes - node_vector_bytes;
+            byte_t const* base = nullptr;
+            graphs_bytes += compress ? node_head_bytes_() + pre_.neighbors_bytes * node.level() + pack_base(node, base)
+                                     : node_bytes - node_vector_bytes;
             vectors_bytes += node_vector_bytes;
         }
         state.bytes_for_graphs = graphs_bytes;
         state.bytes_for_vectors = vectors_bytes;
         state.bytes_checksum = 0;
+        state.flags = (config_.cache_distances ? file_head_t::cached_distances_k : 0) |
+                      (compress ? file_head_t::compressed_base_k : 0);
 
         // Perform serialization
         auto write_chunk = [&](void* begin, std::size_t length) {
@@ -2423,11 +4213,26 @@ class index_gt {
 
         // Serialize nodes one by one
         for (std::size_t i = 0; i != state.size; ++i) {
-            node_t node = node_with_id_(i);
+            node_t node = node_refreshed_(node_with_id_(i), refreshed.data());
             std::size_t node_bytes = node_bytes_(node);
             std::size_t node_vector_bytes = node_vector_bytes_(node);
-            // Dump neighbors and vectors, as vectors may be in a disjoint location
-            write_chunk(node.tape(), node_bytes - node_vector_bytes);
+            // Dump neighbors and vectors, as vectors may be in a disjoint location.
+            // The compressed base list goes after the upper ones, as only it varies in size.
+            if (compress) {
+                std::size_t upper_bytes = pre_.neighbors_bytes * node.level();
+                byte_t const* base = nullptr;
+                std::size_t base_bytes = pack_base(node, base);
+                write_chunk(node.tape(), node_head_bytes_());
+                if (result.error)
+                    return result;
+                if (upper_bytes)
+                    write_chunk(neighbors_upper_tape_(node), upper_bytes);
+                if (result.error)
+                    return result;
+                write_chunk((void*)base, base_bytes);
+            } else {
+                write_chunk(node.tape(), node_bytes - node_vector_bytes);
+            }
             if (result.error)
                 return result;
             write_chunk(node.vector(), node_vector_bytes);
@@ -2443,6 +4248,7 @@ class index_gt {
     /**
      *  @brief  Loads the serialized binary index representation from disk,
      *          copying both vectors and neighbors lists into RAM.
+     *          The lists saved with other IDs, like `uint32_t` ones, are re-encoded into `id_t`.
      *          Available on Linux, MacOS, Windows.
      */
     template <typename progress_at = dummy_progress_t>
@@ -2454,6 +4260,7 @@ class index_gt {
         // Start parsing the files
         serialization_result_t result;
         file_header_t state_buffer{};
+        std::size_t file_id_bytes = sizeof(id_t);
         std::FILE* file = std::fopen(file_path, "rb");
         if (!file)
             return result.failed(std::strerror(errno));
@@ -2477,13 +4284,19 @@ class index_gt {
                 std::fclose(file);
                 return result.failed("Incompatible label type!");
             }
-            if (state.bytes_per_id != sizeof(id_t)) {
+            if (!state.bytes_per_id || state.bytes_per_id > sizeof(std::uint64_t)) {
                 std::fclose(file);
                 return result.failed("Incompatible ID type!");
             }
+            if (!ids_fit_(state.size)) {
+                std::fclose(file);
+                return result.failed("Too many members for the ID type!");
+            }
 
             config_.connectivity = state.connectivity;
             config_.vector_alignment = state.vector_alignment;
+            config_.cache_distances = state.flags & file_head_t::cached_distances_k;
+            config_.compressed_base = state.flags & file_head_t::compressed_base_k;
             pre_ = precompute_(config_);
 
             index_limits_t limits;
@@ -2493,9 +4306,55 @@ class index_gt {
                 return result.failed("Out of memory");
             }
             size_ = state.size;
-            max_level_ = static_cast<level_t>(state.max_level);
-            entry_id_ = static_cast<id_t>(state.entry_idx);
+            store_entry_point_({static_cast<level_t>(state.max_level), static_cast<id_t>(state.entry_idx)});
+            file_id_bytes = state.bytes_per_id;
+        }
+
+        // Lists of files with other IDs, like `uint32_t` ones loaded into a `uint40_t` index,
+        // are read into a separate buffer, to be re-encoded one by one
+        std::size_t const file_edge_bytes = file_id_bytes + sizeof(distance_t) * config_.cache_distances;
+        std::size_t const file_neighbors_bytes = config_.connectivity * file_edge_bytes + sizeof(neighbors_count_t);
+        std::size_t const file_base_bytes =
+            config_.compressed_base ? 0 : pre_.connectivity_max_base * file_edge_bytes + sizeof(neighbors_count_t);
+        buffer_gt<byte_t, dynamic_allocator_t> file_lists;
+        bool const convert_ids = file_id_bytes != sizeof(id_t);
+
+        // The compressed base lists are read byte by byte, until the last varint, and then expanded
+        buffer_gt<byte_t, dynamic_allocator_t> packed;
+        if (config_.compressed_base && !packed.resize(base_packed_limit_())) {
+            std::fclose(file);
+            return result.failed("Out of memory!");
         }
+        auto read_base = [&](node_t node) {
+            byte_t* packed_end = packed.data();
+            for (std::size_t idx = 0, varints = 1; idx != varints && !result.error; ++idx) {
+                do {
+                    if (static_cast<std::size_t>(packed_end - packed.data()) == base_packed_limit_()) {
+                        std::fclose(file);
+                        result.failed("Corrupted neighbors list!");
+                        return;
+                    }
+                    read_chunk(packed_end, 1);
+                } while (!result.error && (static_cast<unsigned char>(*packed_end++) & 0x80));
+                if (idx || result.error)
+                    continue;
+                byte_t const* input = packed.data();
+                varints += static_cast<std::size_t>(varint_load_(input));
+                if (varints > pre_.connectivity_max_base + 1) {
+                    std::fclose(file);
+                    result.failed("Corrupted neighbors list!");
+                    return;
+                }
+            }
+            if (result.error)
+                return;
+            byte_t const* input = packed.data();
+            std::size_t distances_bytes = config_.cache_distances * varint_load_(input) * sizeof(distance_t);
+            if (distances_bytes)
+                read_chunk(packed_end, distances_bytes);
+            if (!result.error)
+                base_unpack_(packed.data(), node.neighbors_tape(), neighbors_distances_(node, 0));
+        };
 
         // Load nodes one by one
         std::size_t const size = size_;
@@ -2513,12 +4372,53 @@ class index_gt {
             if (result.error)
                 return result;
 
-            std::size_t node_bytes = node_bytes_(dim, level);
-            node_t node = node_malloc_(dim, level);
+            if (config_.contiguous_dimensions && dim > config_.contiguous_dimensions) {
+                std::fclose(file);
+                return result.failed("Vector doesn't fit into the contiguous storage!");
+            }
+
+            // The file stores the vectors right after the tapes, but those may be placed in separate slots
+            node_bytes_split_t node_bytes = node_malloc_(dim * !config_.contiguous_dimensions, level);
+            if (config_.contiguous_dimensions)
+                node_bytes.vector = {(byte_t*)vector_slot_(i), node_vector_bytes_(dim)};
+            node_t node = node_bytes;
             node.label(label);
             node.dim(dim);
             node.level(level);
-            read_chunk(node.tape() + node_head_bytes_(), node_bytes - node_head_bytes_());
+            if (convert_ids) {
+                std::size_t lists_bytes = file_base_bytes + file_neighbors_bytes * level;
+                if (!file_lists.resize(lists_bytes)) {
+                    std::fclose(file);
+                    return result.failed("Out of memory!");
+                }
+                if (lists_bytes)
+                    read_chunk(file_lists.data(), lists_bytes);
+                if (result.error)
+                    return result;
+                bool fit = config_.compressed_base || neighbors_convert_(file_lists.data(), file_id_bytes, node, 0);
+                for (level_t l = 1; l <= level && fit; ++l)
+                    fit = neighbors_convert_(file_lists.data() + file_base_bytes + file_neighbors_bytes * (l - 1),
+                                             file_id_bytes, node, l);
+                if (!fit) {
+                    node_free_(node);
+                    std::fclose(file);
+                    return result.failed("Corrupted neighbors list!");
+                }
+                if (config_.compressed_base)
+                    read_base(node);
+            } else if (config_.compressed_base) {
+                std::size_t upper_bytes = pre_.neighbors_bytes * level;
+                if (upper_bytes)
+                    read_chunk(neighbors_upper_tape_(node), upper_bytes);
+                if (!result.error)
+                    read_base(node);
+            } else {
+                read_chunk(node.tape() + node_head_bytes_(), node_bytes.tape.size() - node_head_bytes_());
+            }
+            if (result.error)
+                return result;
+            if (node_bytes.vector.size())
+                read_chunk(node_bytes.vector.data(), node_bytes.vector.size());
             if (result.error)
                 return result;
             nodes_[i] = node;
@@ -2585,7 +4485,12 @@ class index_gt {
         }
 
         // Map the entire file
-        byte_t* file = (byte_t*)mmap(NULL, file_stat.st_size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+        int flags = MAP_PRIVATE;
+#if defined(MAP_POPULATE)
+        if (config_.pages.populate)
+            flags |= MAP_POPULATE;
+#endif
+        byte_t* file = (byte_t*)mmap(NULL, file_stat.st_size, PROT_READ, flags, descriptor, 0);
         if (file == MAP_FAILED) {
             close(descriptor);
             return result.failed(std::strerror(errno));
@@ -2594,6 +4499,8 @@ class index_gt {
         viewed_file_.ptr = file;
         viewed_file_.length = file_stat.st_size;
 #endif // Platform specific code
+        viewed_file_.pages.page_bytes = default_page_bytes();
+        advise_memory_pages(viewed_file_.ptr, viewed_file_.length, config_.pages, viewed_file_.pages);
 
         // Read the header
         {
@@ -2609,6 +4516,9 @@ class index_gt {
 
             config_.connectivity = state.connectivity;
             config_.vector_alignment = state.vector_alignment;
+            config_.cache_distances = state.flags & file_head_t::cached_distances_k;
+            config_.compressed_base = state.flags & file_head_t::compressed_base_k;
+            config_.contiguous_dimensions = 0; // The vectors stay next to the tapes in the file
             pre_ = precompute_(config_);
 
             index_limits_t limits;
@@ -2618,8 +4528,7 @@ class index_gt {
                 return result.failed("Out of memory!");
 
             size_ = state.size;
-            max_level_ = static_cast<level_t>(state.max_level);
-            entry_id_ = static_cast<id_t>(state.entry_idx);
+            store_entry_point_({static_cast<level_t>(state.max_level), static_cast<id_t>(state.entry_idx)});
         }
 
         // Locate every node packed into file
@@ -2632,6 +4541,10 @@ class index_gt {
 
             std::size_t node_bytes = node_bytes_(dim, level);
             std::size_t node_vector_bytes = dim * sizeof(scalar_t);
+            if (config_.compressed_base) {
+                std::size_t tape_bytes = node_head_bytes_() + pre_.neighbors_bytes * level;
+                node_bytes = tape_bytes + base_unpack_(tape + tape_bytes, nullptr, nullptr) + node_vector_bytes;
+            }
             nodes_[i] = node_t{tape, (scalar_t*)(tape + node_bytes - node_vector_bytes)};
             progress_bytes += node_bytes;
             progress(i, size);
@@ -2640,6 +4553,21 @@ class index_gt {
         return {};
     }
 
+    /**
+     *  @brief  Exposes the part of the memory-mapped file following the serialized index,
+     *          where higher-level wrappers may keep their own state. Empty, unless viewed.
+     */
+    span_gt<byte_t const> viewed_tail() const noexcept {
+        if (!viewed_file_)
+            return {};
+        byte_t* file = (byte_t*)viewed_file_.ptr;
+        file_head_t state{file};
+        std::size_t offset = sizeof(file_header_t) + state.bytes_for_graphs + state.bytes_for_vectors;
+        if (offset >= viewed_file_.length)
+            return {};
+        return {file + offset, viewed_file_.length - offset};
+    }
+
 #pragma endregion
 
     struct join_result_t {
@@ -2724,19 +4652,237 @@ class index_gt {
             node_t node = node_with_id_(node_idx);
             for (level_t level = 0; level <= node.level(); ++level) {
                 neighbors_ref_t neighbors = neighbors_(node, level);
+                byte_t* distances = neighbors_distances_(node, level);
                 std::size_t old_size = neighbors.size();
                 neighbors.clear();
                 for (std::size_t i = 0; i != old_size; ++i) {
                     id_t neighbor_id = neighbors[i];
                     node_t neighbor = node_with_id_(neighbor_id);
+                    distance_t distance = distances ? neighbor_distance_(distances, i) : distance_t{};
                     if (allow_member(member_cref_t{neighbor.label(), neighbor.vector_view(), neighbor_id}))
-                        neighbors.push_back(neighbor_id);
+                        push_neighbor_(neighbors, distances, {distance, neighbor_id});
                 }
             }
         });
     }
 
+    struct refine_result_t {
+        error_t error{};
+        /// @brief Number of edges, that were replaced with closer or more diverse ones.
+        std::size_t replaced_edges{};
+        std::size_t cycles{};
+        std::size_t measurements{};
+
+        explicit operator bool() const noexcept { return !error; }
+        refine_result_t failed(error_t message) noexcept {
+            error = std::move(message);
+            return std::move(*this);
+        }
+    };
+
+    /**
+     *  @brief  Improves the edges of an already constructed graph, without rebuilding it.
+     *          For every node and level, pools the current neighbors with their own neighbors,
+     *          and re-selects the list with the same heuristic, that `add` uses. It's similar
+     *          to a round of NN-Descent, and helps to recover the recall after a fast construction
+     *          with a low `expansion_add`, or after the inserted data has drifted.
+     *
+     *  Only rewrites the outgoing links of every node, so it's safe to call repeatedly,
+     *  but shouldn't overlap with concurrent insertions, as those may lose their links.
+     *
+     *  @param[in] executor Thread-pool to execute the job in parallel.
+     *  @param[in] progress Callback to report the execution progress.
+     */
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t>
+    refine_result_t refine_graph(               //
+        executor_at&& executor = executor_at{}, //
+        progress_at&& progress = progress_at{}) usearch_noexcept_m {
+
+        usearch_assert_m(!is_immutable(), "Can't refine an immutable index");
+        refine_result_t result;
+        if (executor.size() > limits_.threads())
+            return result.failed("Executor has more threads than the index has contexts!");
+
+        // Every thread keeps a copy of the list being refined, and a bounded pool of candidates
+        std::size_t const top_limit = (std::max)(pre_.connectivity_max_base, default_expansion_add());
+        buffer_gt<candidate_t> old_neighbors;
+        if (!old_neighbors.resize(executor.size() * pre_.connectivity_max_base))
+            return result.failed("Out of memory!");
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            context_t& context = contexts_[thread_idx];
+            if (!context.top_candidates.reserve(top_limit) || !context.reserve_successors(pre_.connectivity_max_base))
+                return result.failed("Out of memory!");
+        }
+
+        // Pull stats
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            result.measurements += contexts_[thread_idx].measurements_count;
+            result.cycles += contexts_[thread_idx].iteration_cycles;
+        }
+
+        std::size_t const count = size();
+        std::atomic<std::size_t> replaced_edges{0};
+        std::atomic<std::size_t> passed{0};
+        std::atomic<bool> out_of_memory{false};
+        executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t node_idx) {
+            context_t& context = contexts_[thread_idx];
+            candidate_t* thread_neighbors = old_neighbors.data() + thread_idx * pre_.connectivity_max_base;
+            id_t id = static_cast<id_t>(node_idx);
+            std::size_t replaced = 0;
+            for (level_t level = 0; level <= node_with_id_(id).level(); ++level)
+                if (!refine_neighbors_(id, level, top_limit, thread_neighbors, replaced, context))
+                    out_of_memory = true;
+            replaced_edges += replaced;
+            progress(++passed, count);
+        });
+        result.replaced_edges = replaced_edges;
+        if (out_of_memory)
+            return result.failed("Out of memory!");
+
+        // Normalize stats
+        std::size_t measurements = 0, cycles = 0;
+        for (std::size_t thread_idx = 0; thread_idx != executor.size(); ++thread_idx) {
+            measurements += contexts_[thread_idx].measurements_count;
+            cycles += contexts_[thread_idx].iteration_cycles;
+        }
+        result.measurements = measurements - result.measurements;
+        result.cycles = cycles - result.cycles;
+        return result;
+    }
+
+    struct reorder_result_t {
+        error_t error{};
+        /// @brief Number of nodes reachable from the entry point on the base level.
+        std::size_t reachable{};
+
+        explicit operator bool() const noexcept { return !error; }
+        reorder_result_t failed(error_t message) noexcept {
+            error = std::move(message);
+            return std::move(*this);
+        }
+    };
+
+    /**
+     *  @brief  Renumbers the nodes in the Breadth-First order of the base level, starting from the entry point,
+     *          and re-allocates them in that order. Neighbors end up with close identifiers, and close addresses
+     *          in memory and in the saved file, so that the graph traversals touch fewer pages.
+     *          Nodes unreachable from the entry point are appended, continuing the traversal from each of them.
+     *
+     *  Not thread-safe. Temporarily needs twice the memory of the nodes.
+     *
+     *  @param[in] relocated Callback receiving the old and the new identifier of every node.
+     *  @param[in] executor Thread-pool to execute the job in parallel.
+     *  @param[in] progress Callback to report the execution progress.
+     */
+    template <                                      //
+        typename relocated_at = dummy_relocation_t, //
+        typename executor_at = dummy_executor_t,    //
+        typename progress_at = dummy_progress_t     //
+        >
+    reorder_result_t reorder(                      //
+        relocated_at&& relocated = relocated_at{}, //
+        executor_at&& executor = executor_at{},    //
+        progress_at&& progress = progress_at{}) noexcept {
+
+        reorder_result_t result;
+        if (is_immutable())
+            return result.failed("Can't reorder an immutable index");
+        std::size_t const count = size();
+        if (!count)
+            return result;
+
+        // Map the identifiers in both directions
+        buffer_gt<id_t> old_ids, new_ids;
+        buffer_gt<node_t> new_nodes;
+        visits_bitset_t visited;
+        if (!old_ids.resize(count) || !new_ids.resize(count) || !new_nodes.resize(count) || !visited.resize(count))
+            return result.failed("Out of memory!");
+
+        // The `old_ids` double as the queue of the traversal
+        std::size_t ordered = 0;
+        std::size_t next_root = 0;
+        id_t entry_id = entry_point_().id;
+        visited.set(entry_id);
+        old_ids[ordered++] = entry_id;
+        for (std::size_t popped = 0; popped != count; ++popped) {
+            if (popped == ordered) {
+                if (!result.reachable)
+                    result.reachable = ordered;
+                while (visited.test(next_root))
+                    ++next_root;
+                visited.set(next_root);
+                old_ids[ordered++] = static_cast<id_t>(next_root);
+            }
+            for (id_t neighbor_id : neighbors_base_(node_with_id_(old_ids[popped])))
+                if (!visited.test(neighbor_id))
+                    visited.set(neighbor_id), old_ids[ordered++] = neighbor_id;
+        }
+        if (!result.reachable)
+            result.reachable = count;
+        for (std::size_t new_id = 0; new_id != count; ++new_id)
+            new_ids[old_ids[new_id]] = static_cast<id_t>(new_id);
+
+        // Copy the nodes one after another into a fresh allocator, so that they are placed close to each other.
+        // Arena allocators release everything at once, so the old nodes can't share it with the new ones.
+        // The contiguous vectors are permuted into fresh slots the same way.
+        vectors_buffer_t old_vectors;
+        if (!vectors_allocate_(limits_.members, old_vectors))
+            return result.failed("Out of memory!");
+        std::swap(vectors_, old_vectors);
+        tape_allocator_t old_tape_allocator = tape_allocator_;
+        std::swap(tape_allocator_, old_tape_allocator);
+        for (std::size_t new_id = 0; new_id != count; ++new_id) {
+            node_t node = node_make_copy_(new_id, node_bytes_split_(node_with_id_(old_ids[new_id])));
+            if (!node) {
+                node_t* old_nodes = exchange(nodes_, new_nodes.data());
+                if (!has_reset<tape_allocator_t>()) {
+                    for (std::size_t i = 0; i != new_id; ++i)
+                        node_free_(i);
+                } else
+                    tape_allocator_.deallocate(nullptr, 0);
+                nodes_ = old_nodes;
+                std::swap(tape_allocator_, old_tape_allocator);
+                std::swap(vectors_, old_vectors);
+                vectors_free_(old_vectors);
+                return result.failed("Out of memory!");
+            }
+            new_nodes[new_id] = node;
+            progress(new_id + 1, count);
+        }
+
+        // Translate the links into new identifiers
+        executor.execute_bulk(count, [&](std::size_t, std::size_t new_id) {
+            node_t node = new_nodes[new_id];
+            for (level_t level = 0; level <= node.level(); ++level) {
+                neighbors_ref_t neighbors = neighbors_(node, level);
+                std::size_t old_size = neighbors.size();
+                neighbors.clear();
+                for (std::size_t i = 0; i != old_size; ++i)
+                    neighbors.push_back(new_ids[neighbors[i]]);
+            }
+        });
+
+        // Release the old nodes with the allocator, that has produced them
+        for (std::size_t old_id = 0; old_id != count; ++old_id)
+            relocated(static_cast<id_t>(old_id), new_ids[old_id]);
+        std::swap(tape_allocator_, old_tape_allocator);
+        if (!has_reset<tape_allocator_t>()) {
+            for (std::size_t old_id = 0; old_id != count; ++old_id)
+                node_free_(old_id);
+        } else
+            tape_allocator_.deallocate(nullptr, 0);
+        std::swap(tape_allocator_, old_tape_allocator);
+        std::memcpy(nodes_, new_nodes.data(), sizeof(node_t) * count);
+        vectors_free_(old_vectors);
+        entry_point_t entry = entry_point_();
+        store_entry_point_({entry.level, new_ids[entry.id]});
+        return result;
+    }
+
   private:
+    /// @brief  Indexes with other identifiers are accessed directly in `convert`.
+    template <typename, typename, typename, typename, typename> friend class index_gt;
+
     template <typename first_to_second_at, typename second_to_first_at, typename executor_at, typename progress_at>
     static join_result_t join_small_and_big_(       //
         index_gt const& men, index_gt const& women, //
@@ -2922,8 +5068,12 @@ class index_gt {
         precomputed_constants_t pre;
         pre.connectivity_max_base = config.connectivity * base_level_multiple_();
         pre.inverse_log_connectivity = 1.0 / std::log(static_cast<double>(config.connectivity));
-        pre.neighbors_bytes = config.connectivity * sizeof(id_t) + sizeof(neighbors_count_t);
-        pre.neighbors_base_bytes = pre.connectivity_max_base * sizeof(id_t) + sizeof(neighbors_count_t);
+        std::size_t edge_bytes = sizeof(id_t) + sizeof(distance_t) * config.cache_distances;
+        pre.neighbors_bytes = config.connectivity * edge_bytes + sizeof(neighbors_count_t);
+        pre.neighbors_base_bytes = pre.connectivity_max_base * edge_bytes + sizeof(neighbors_count_t);
+        std::size_t vector_bytes = config.contiguous_dimensions * sizeof(scalar_t);
+        pre.vector_alignment = (std::max)(std::size_t(64), config.vector_alignment);
+        pre.vector_stride = divide_round_up(vector_bytes, pre.vector_alignment) * pre.vector_alignment;
         return pre;
     }
 
@@ -2954,35 +5104,104 @@ class index_gt {
     inline std::size_t node_vector_bytes_(dim_t dim) const noexcept { return dim * sizeof(scalar_t); }
     inline std::size_t node_vector_bytes_(node_t node) const noexcept { return node_vector_bytes_(node.dim()); }
 
-    node_bytes_split_t node_malloc_(dim_t dims_to_store, level_t level) noexcept {
+    /**
+     *  @brief  Allocates from the arena of the given thread, if the tape allocator keeps one per thread,
+     *          skipping its shared lock. Only the exclusive owner of a context may pass its index.
+     */
+    byte_t* tape_allocate_(std::size_t bytes, std::size_t thread) noexcept {
+        using threaded_t = std::integral_constant<bool, has_thread_allocate_gt<tape_allocator_t>::value>;
+        return tape_allocate_(bytes, thread, threaded_t{});
+    }
+    byte_t* tape_allocate_(std::size_t bytes, std::size_t thread, std::true_type) noexcept {
+        return (byte_t*)tape_allocator_.allocate(bytes, thread);
+    }
+    byte_t* tape_allocate_(std::size_t bytes, std::size_t, std::false_type) noexcept {
+        return (byte_t*)tape_allocator_.allocate(bytes);
+    }
+
+    node_bytes_split_t node_malloc_(dim_t dims_to_store, level_t level, std::size_t thread = 0) noexcept {
 
         std::size_t vector_bytes = node_vector_bytes_(dims_to_store);
         std::size_t node_bytes = node_bytes_(dims_to_store, level);
         std::size_t non_vector_bytes = node_bytes - vector_bytes;
 
-        byte_t* data = (byte_t*)tape_allocator_.allocate(node_bytes);
+        byte_t* data = tape_allocate_(node_bytes, thread);
         if (!data)
             return node_bytes_split_t{};
         return {{data, non_vector_bytes}, {data + non_vector_bytes, vector_bytes}};
     }
 
-    node_t node_make_(label_t label, vector_view_t vector, level_t level, bool store_vector) noexcept {
-        node_bytes_split_t node_bytes = node_malloc_(vector.size() * store_vector, level);
-        if (store_vector) {
+    /**
+     *  @brief  Allocates the id-indexed slots for ::members vectors, if `config_.contiguous_dimensions`
+     *          is set. Over-allocates to align the first slot manually, as the allocator may not.
+     */
+    bool vectors_allocate_(std::size_t members, vectors_buffer_t& buffer) noexcept {
+        buffer = {};
+        if (!config_.contiguous_dimensions || !members)
+            return true;
+        std::size_t bytes = members * pre_.vector_stride + pre_.vector_alignment;
+        byte_t* allocation = dynamic_allocator_.allocate(bytes);
+        if (!allocation)
+            return false;
+        std::size_t misalignment = reinterpret_cast<std::uintptr_t>(allocation) % pre_.vector_alignment;
+        buffer.allocation = allocation;
+        buffer.data = allocation + (misalignment ? pre_.vector_alignment - misalignment : 0);
+        buffer.bytes = bytes;
+        return true;
+    }
+
+    void vectors_free_(vectors_buffer_t& buffer) noexcept {
+        if (buffer.allocation)
+            dynamic_allocator_.deallocate(buffer.allocation, buffer.bytes);
+        buffer = {};
+    }
+
+    inline bool fits_slot_(vector_view_t vector) const noexcept {
+        return !config_.contiguous_dimensions || vector.size() <= config_.contiguous_dimensions;
+    }
+
+    inline scalar_t* vector_slot_(std::size_t id) const noexcept {
+        return reinterpret_cast<scalar_t*>(vectors_.data + id * pre_.vector_stride);
+    }
+
+    node_t node_make_(                                                                       //
+        std::size_t id, label_t label, vector_view_t vector, level_t level, bool store_vector, //
+        std::size_t thread) noexcept {
+        bool in_tape = store_vector && !config_.contiguous_dimensions;
+        node_bytes_split_t node_bytes = node_malloc_(vector.size() * in_tape, level, thread);
+        if (!node_bytes.tape.data())
+            return node_t{};
+        if (in_tape) {
             std::memset(node_bytes.tape.data(), 0, node_bytes.tape.size());
             std::memcpy(node_bytes.vector.data(), vector.data(), node_bytes.vector.size());
         } else {
             std::memset(node_bytes.tape.data(), 0, node_bytes.memory_usage());
+            node_bytes.vector = {(byte_t*)vector.data(), node_vector_bytes_(static_cast<dim_t>(vector.size()))};
         }
         node_t node = node_bytes;
         node.label(label);
         node.dim(static_cast<dim_t>(vector.size()));
         node.level(level);
-        return node;
+        return store_vector && !in_tape ? node_slot_(node, id, vector) : node;
+    }
+
+    /// @brief  Copies the ::vector into the contiguous slot of ::id, pointing the ::node at it.
+    node_t node_slot_(node_t node, std::size_t id, vector_view_t vector) noexcept {
+        scalar_t* slot = vector_slot_(id);
+        std::memcpy(slot, vector.data(), node_vector_bytes_(static_cast<dim_t>(vector.size())));
+        return node_t{node.tape(), slot};
     }
 
-    node_t node_make_copy_(node_bytes_split_t old_bytes) noexcept {
-        if (old_bytes.colocated()) {
+    node_t node_make_copy_(std::size_t id, node_bytes_split_t old_bytes) noexcept {
+        if (config_.contiguous_dimensions) {
+            byte_t* data = (byte_t*)tape_allocator_.allocate(old_bytes.tape.size());
+            if (!data)
+                return node_t{};
+            scalar_t* vector = vector_slot_(id);
+            std::memcpy(data, old_bytes.tape.data(), old_bytes.tape.size());
+            std::memcpy(vector, old_bytes.vector.data(), old_bytes.vector.size());
+            return node_t{data, vector};
+        } else if (old_bytes.colocated()) {
             byte_t* data = (byte_t*)tape_allocator_.allocate(old_bytes.memory_usage());
             std::memcpy(data, old_bytes.tape.data(), old_bytes.memory_usage());
             return node_t{data, reinterpret_cast<scalar_t*>(data + old_bytes.tape.size())};
@@ -3000,23 +5219,277 @@ class index_gt {
         if (viewed_file_)
             return;
 
-        node_t& node = nodes_[id];
-        std::size_t node_bytes = node_bytes_(node) - node_vector_bytes_(node) * !node_bytes_split_(node).colocated();
+        node_free_(nodes_[id]);
+        nodes_[id] = node_t{};
+    }
+
+    /**
+     *  @brief  Returns the ::node to the allocator with the same size, that `node_make_` has requested.
+     *          The vector was allocated in the tape only if it follows the neighbors lists, as the
+     *          vectors, that weren't stored, are referenced in the memory of the caller.
+     */
+    void node_free_(node_t node) noexcept {
+        bool external = config_.contiguous_dimensions || !node_bytes_split_(node).colocated();
+        std::size_t node_bytes = node_bytes_(node) - node_vector_bytes_(node) * external;
         tape_allocator_.deallocate(node.tape(), node_bytes);
-        node = node_t{};
+    }
+
+    /**
+     *  @brief  Frees the ::node, replaced in `nodes_`, once the traversals, that may have read it, finish.
+     *          Must be called outside of the `epoch_enter_` scope of the calling thread.
+     */
+    void node_retire_(node_t node) noexcept {
+        std::unique_lock<std::mutex> lock(retired_mutex_);
+        std::size_t epoch = epoch_.fetch_add(1);
+        if (retired_nodes_.size() != retired_nodes_.capacity() || retired_nodes_.reserve(retired_nodes_.size() * 2))
+            retired_nodes_.push({node, epoch});
+        else {
+            // Without memory to defer the reclamation, wait for the traversals to finish
+            spin_backoff_t backoff;
+            while (oldest_epoch_() <= epoch)
+                backoff.wait();
+            node_free_(node);
+        }
+
+        retired_node_t retired;
+        std::size_t oldest_epoch = oldest_epoch_();
+        while (!retired_nodes_.empty() && retired_nodes_[0].epoch < oldest_epoch) {
+            retired_nodes_.try_pop(retired);
+            node_free_(retired.node);
+        }
+    }
+
+    /// @brief  The earliest epoch, that a running traversal may have started in.
+    std::size_t oldest_epoch_() const noexcept {
+        std::size_t oldest_epoch = epoch_.load();
+        for (std::size_t i = 0; i != limits_.threads(); ++i) {
+            std::size_t epoch = contexts_[i].epoch.load();
+            if (epoch && epoch < oldest_epoch)
+                oldest_epoch = epoch;
+        }
+        return oldest_epoch;
+    }
+
+    /**
+     *  @brief  Frees the nodes, allocated past the `size()` by a bulk insertion, that has failed
+     *          before publishing those. The slots, that were never allocated, are skipped.
+     */
+    void nodes_release_(std::size_t first, std::size_t count) noexcept {
+        for (std::size_t id = first; id != first + count; ++id)
+            if (nodes_[id])
+                node_free_(id);
     }
 
     inline node_t node_with_id_(std::size_t idx) const noexcept { return nodes_[idx]; }
     inline neighbors_ref_t neighbors_base_(node_t node) const noexcept { return {node.neighbors_tape()}; }
 
+    /// @brief  Base neighbors for the traversals, decoded into the ::context, if the viewed file has those compressed.
+    inline neighbors_ref_t neighbors_base_(node_t node, context_t& context) const noexcept {
+        if (!base_packed_())
+            return neighbors_base_(node);
+        byte_t* unpacked = context.unpacked_base.data();
+        base_unpack_(base_packed_tape_(node), unpacked, nullptr);
+        return {unpacked};
+    }
+
     inline neighbors_ref_t neighbors_non_base_(node_t node, level_t level) const noexcept {
-        return {node.neighbors_tape() + pre_.neighbors_base_bytes + (level - 1) * pre_.neighbors_bytes};
+        return {neighbors_upper_tape_(node) + (level - 1) * pre_.neighbors_bytes};
+    }
+
+    /// @brief  Start of the upper levels lists, that precede the compressed base list in viewed files.
+    inline byte_t* neighbors_upper_tape_(node_t node) const noexcept {
+        return node.neighbors_tape() + (base_packed_() ? 0 : pre_.neighbors_base_bytes);
+    }
+
+    inline std::size_t neighbors_count_(node_t node, level_t level) const noexcept {
+        if (level || !base_packed_())
+            return neighbors_(node, level).size();
+        byte_t const* packed = base_packed_tape_(node);
+        return static_cast<std::size_t>(varint_load_(packed));
+    }
+
+    inline bool base_packed_() const noexcept { return viewed_file_ && config_.compressed_base; }
+    inline byte_t* base_packed_tape_(node_t node) const noexcept {
+        return node.neighbors_tape() + pre_.neighbors_bytes * node.level();
+    }
+
+    /// @brief  Upper bound on the size of a compressed base list, with every varint at its longest.
+    inline std::size_t base_packed_limit_() const noexcept {
+        return (pre_.connectivity_max_base + 1) * (varint_max_bytes_() + sizeof(distance_t));
+    }
+
+    static constexpr std::size_t varint_max_bytes_() { return 10; }
+
+    /// @brief  Stores the ::value in 7-bit groups, the lowest first, with the highest bit marking continuation.
+    static std::size_t varint_store_(std::uint64_t value, byte_t* output) noexcept {
+        std::size_t bytes = 1;
+        for (; value >= 0x80; value >>= 7, ++bytes)
+            *output++ = static_cast<byte_t>(value | 0x80);
+        *output = static_cast<byte_t>(value);
+        return bytes;
+    }
+
+    static std::uint64_t varint_load_(byte_t const*& input) noexcept {
+        std::uint64_t value = 0;
+        for (unsigned shift = 0;; shift += 7) {
+            unsigned char group = static_cast<unsigned char>(*input++);
+            value |= std::uint64_t(group & 0x7F) << shift;
+            if (!(group & 0x80))
+                return value;
+        }
+    }
+
+    /**
+     *  @brief  Compresses the base neighbors list of a ::node, sorting it by IDs and storing the count
+     *          and the gaps between the consecutive IDs as varints, followed by the cached distances.
+     *  @param[in] sorted Scratch space for the whole list.
+     *  @return The number of bytes written into ::packed.
+     */
+    std::size_t base_pack_(node_t node, candidate_t* sorted, byte_t* packed) const noexcept {
+        neighbors_ref_t neighbors = neighbors_base_(node);
+        byte_t* distances = neighbors_distances_(node, 0);
+        std::size_t const count = neighbors.size();
+        for (std::size_t idx = 0; idx != count; ++idx)
+            sorted[idx] = {distances ? neighbor_distance_(distances, idx) : distance_t{}, neighbors[idx]};
+        std::sort(sorted, sorted + count, [](candidate_t const& a, candidate_t const& b) {
+            return static_cast<std::size_t>(a.id) < static_cast<std::size_t>(b.id);
+        });
+
+        std::size_t bytes = varint_store_(count, packed);
+        std::size_t previous = 0;
+        for (std::size_t idx = 0; idx != count; ++idx) {
+            std::size_t id = static_cast<std::size_t>(sorted[idx].id);
+            bytes += varint_store_(id - previous, packed + bytes);
+            previous = id;
+        }
+        for (std::size_t idx = 0; distances && idx != count; ++idx, bytes += sizeof(distance_t))
+            misaligned_store<distance_t>(packed + bytes, sorted[idx].distance);
+        return bytes;
+    }
+
+    /**
+     *  @brief  Expands a base list, compressed with `base_pack_`, into the ::neighbors_tape and ::distances,
+     *          either of which can be a `nullptr`, to skip over the list or to only restore the IDs.
+     *  @return The number of bytes read from ::packed.
+     */
+    std::size_t base_unpack_(byte_t const* packed, byte_t* neighbors_tape, byte_t* distances) const noexcept {
+        byte_t const* input = packed;
+        std::size_t const count = static_cast<std::size_t>(varint_load_(input));
+        if (neighbors_tape)
+            neighbors_ref_t{neighbors_tape}.clear();
+        std::size_t id = 0;
+        for (std::size_t idx = 0; idx != count; ++idx) {
+            id += static_cast<std::size_t>(varint_load_(input));
+            if (neighbors_tape)
+                neighbors_ref_t{neighbors_tape}.push_back(static_cast<id_t>(id));
+        }
+        if (!config_.cache_distances)
+            return static_cast<std::size_t>(input - packed);
+        if (distances && count)
+            std::memcpy(distances, input, count * sizeof(distance_t));
+        return static_cast<std::size_t>(input - packed) + count * sizeof(distance_t);
     }
 
     inline neighbors_ref_t neighbors_(node_t node, level_t level) const noexcept {
         return level ? neighbors_non_base_(node, level) : neighbors_base_(node);
     }
 
+    /**
+     *  @brief  Distances to the neighbors on a ::level, stored in the tape right after their IDs.
+     *  @return `nullptr`, unless `index_config_t::cache_distances` is enabled.
+     */
+    inline byte_t* neighbors_distances_(node_t node, level_t level) const noexcept {
+        if (!config_.cache_distances)
+            return nullptr;
+        std::size_t capacity = level ? config_.connectivity : pre_.connectivity_max_base;
+        byte_t* tape = level ? node.neighbors_tape() + pre_.neighbors_base_bytes + (level - 1) * pre_.neighbors_bytes
+                             : node.neighbors_tape();
+        return tape + sizeof(neighbors_count_t) + capacity * sizeof(id_t);
+    }
+
+    /// @brief  Checks if the IDs of ::count members can be represented with `id_t`.
+    static bool ids_fit_(std::size_t count) noexcept {
+        std::size_t const id_bits = sizeof(id_t) * CHAR_BIT;
+        // Shifting in two steps, as shifting by the full width of the type is undefined
+        return !(count >> (id_bits - 1) >> 1);
+    }
+
+    /**
+     *  @brief  Re-encodes the list on a ::level from a ::file_tape with ::file_id_bytes wide IDs,
+     *          such as a `uint32_t` one in a `uint40_t` index, copying the cached distances as well.
+     *  @return `false` if the list of a corrupt or foreign file doesn't fit into the ::level of the ::node.
+     */
+    bool neighbors_convert_(byte_t* file_tape, std::size_t file_id_bytes, node_t node, level_t level) const noexcept {
+        std::size_t const capacity = level ? config_.connectivity : pre_.connectivity_max_base;
+        std::size_t const count = misaligned_load<neighbors_count_t>(file_tape);
+        if (count > capacity)
+            return false;
+        byte_t const* file_ids = file_tape + sizeof(neighbors_count_t);
+        neighbors_ref_t neighbors = neighbors_(node, level);
+        neighbors.clear();
+        for (std::size_t idx = 0; idx != count; ++idx) {
+            std::uint64_t id = 0; // IDs of all widths are stored in little-endian order
+            std::memcpy(&id, file_ids + idx * file_id_bytes, file_id_bytes);
+            neighbors.push_back(static_cast<id_t>(static_cast<std::size_t>(id)));
+        }
+        byte_t* distances = neighbors_distances_(node, level);
+        if (distances && count)
+            std::memcpy(distances, file_ids + capacity * file_id_bytes, count * sizeof(distance_t));
+        return true;
+    }
+
+    static distance_t neighbor_distance_(byte_t* distances, std::size_t idx) noexcept {
+        return misaligned_load<distance_t>(distances + idx * sizeof(distance_t));
+    }
+
+    /**
+     *  @brief  Copies the head and the neighbors lists of a ::node into the ::tape, re-measuring the
+     *          distances, that it has cached to the updated nodes, so that those aren't saved stale.
+     *  @return The ::node itself, if none of its cached distances is stale, or its copy otherwise.
+     */
+    node_t node_refreshed_(node_t node, byte_t* tape) const noexcept {
+        // The viewed files are immutable, so nothing is stale there
+        bool stale = false;
+        for (level_t level = 0; level <= node.level() && config_.cache_distances && !viewed_file_ && !stale; ++level)
+            for (id_t neighbor_id : neighbors_(node, level))
+                stale = stale || nodes_updated_.test(neighbor_id);
+        if (!stale)
+            return node;
+
+        node_t copy{tape, node.vector()};
+        std::memcpy(tape, node.tape(), node_bytes_(node) - node_vector_bytes_(node));
+        for (level_t level = 0; level <= node.level(); ++level) {
+            neighbors_ref_t neighbors = neighbors_(copy, level);
+            byte_t* distances = neighbors_distances_(copy, level);
+            for (std::size_t idx = 0; idx != neighbors.size(); ++idx) {
+                if (!nodes_updated_.test(neighbors[idx]))
+                    continue;
+                distance_t distance = metric_(node.vector_view(), node_with_id_(neighbors[idx]).vector_view());
+                misaligned_store<distance_t>(distances + idx * sizeof(distance_t), distance);
+            }
+        }
+        return copy;
+    }
+
+    /**
+     *  @brief  Distance from a ::node to its neighbor at ::idx, as cached in its ::distances,
+     *          or re-measured, if `update` has replaced the vector of that neighbor since.
+     */
+    distance_t cached_distance_(                                         //
+        node_t node, byte_t* distances, std::size_t idx, id_t neighbor_id, //
+        context_t& context) const noexcept {
+        if (!nodes_updated_.atomic_test(neighbor_id))
+            return neighbor_distance_(distances, idx);
+        return context.measure(node, node_with_id_(neighbor_id));
+    }
+
+    /// @brief  Appends a neighbor, and its distance, if those are cached.
+    static void push_neighbor_(neighbors_ref_t neighbors, byte_t* distances, candidate_t candidate) noexcept {
+        if (distances)
+            misaligned_store<distance_t>(distances + neighbors.size() * sizeof(distance_t), candidate.distance);
+        neighbors.push_back(candidate.id);
+    }
+
     struct node_lock_t {
         visits_bitset_t& bitset;
         std::size_t idx;
@@ -3024,27 +5497,179 @@ class index_gt {
         inline ~node_lock_t() noexcept { bitset.atomic_reset(idx); }
     };
 
-    inline node_lock_t node_lock_(std::size_t idx) const noexcept {
-        while (nodes_mutexes_.atomic_set(idx))
-            ;
+    /**
+     *  @brief  Test-and-test-and-set spin-lock with exponential backoff.
+     *          While waiting, only reads the lock, not to bounce its cache line between cores.
+     */
+    inline node_lock_t node_lock_(std::size_t idx, context_t& context) const noexcept {
+        context.lock_acquisitions++;
+        if (nodes_mutexes_.atomic_set(idx)) {
+            spin_backoff_t backoff;
+            do {
+                while (nodes_mutexes_.atomic_test(idx)) {
+                    backoff.wait();
+                    context.lock_spins++;
+                }
+            } while (nodes_mutexes_.atomic_set(idx));
+        }
         return {nodes_mutexes_, idx};
     }
 
-    void connect_node_across_levels_(                           //
-        id_t node_id, vector_view_t vector,                     //
-        id_t entry_id, level_t max_level, level_t target_level, //
-        add_config_t const& config, context_t& context) usearch_noexcept_m {
-
-        // Go down the level, tracking only the closest match
-        id_t closest_id = search_for_one_(entry_id, vector, max_level, target_level, context);
+    /**
+     *  @brief  Marks the neighbors lists of a node as being modified, until the end of the scope,
+     *          so that the optimistic readers in `search_for_one_` retry. Requires `node_lock_`.
+     */
+    struct node_write_t {
+        versions_t& versions;
+        std::size_t idx;
+
+        inline ~node_write_t() noexcept { versions.write_end(idx); }
+    };
+
+    inline node_write_t node_write_(std::size_t idx) noexcept {
+        nodes_versions_.write_begin(idx);
+        return {nodes_versions_, idx};
+    }
+
+    /**
+     *  @brief  Marks the ::context as traversing the graph until the end of the scope,
+     *          so that the nodes, that `update` replaces meanwhile, aren't freed under it.
+     *          Nested scopes of the same context are covered by the outermost one.
+     */
+    struct epoch_guard_t {
+        std::atomic<std::size_t>& epoch;
+        bool owned;
+
+        inline ~epoch_guard_t() noexcept { leave(); }
+        inline void leave() noexcept {
+            if (exchange(owned, false))
+                epoch.store(0);
+        }
+    };
+
+    inline epoch_guard_t epoch_enter_(context_t& context) const noexcept {
+        if (context.epoch.load(std::memory_order_relaxed))
+            return {context.epoch, false};
+        // Re-check the counter, in case a node was retired before the context was marked
+        std::size_t epoch;
+        do {
+            epoch = epoch_.load();
+            context.epoch.store(epoch);
+        } while (epoch_.load() != epoch);
+        return {context.epoch, true};
+    }
+
+    void connect_node_across_levels_(                           //
+        id_t node_id, vector_view_t vector,                     //
+        id_t entry_id, level_t max_level, level_t target_level, //
+        add_config_t const& config, context_t& context,         //
+        level_t last_level = 0) usearch_noexcept_m {
+
+        // Go down the level, tracking only the closest match
+        id_t closest_id = search_for_one_(entry_id, vector, max_level, target_level, config.prefetch_depth, context);
+
+        // From `target_level` down to `last_level` perform proper extensive search
+        for (level_t level = (std::min)(target_level, max_level); level >= last_level; --level) {
+            // TODO: Handle out of memory conditions
+            search_to_insert_(node_id, closest_id, vector, level, config.expansion, config.prefetch_depth, context);
+            if (!context.top_candidates.size())
+                continue;
+            closest_id = connect_new_node_(node_id, level, context);
+            reconnect_neighbor_nodes_(node_id, level, context);
+        }
+    }
+
+    /**
+     *  @brief  Links an already allocated node, promoting it to the entry point, if it's the highest.
+     *          Concurrent insertions don't wait for each other: the promotion happens after linking,
+     *          so two nodes rising above the old `max_level()` at once won't see each other on the
+     *          new levels, and only the higher one will become the entry point.
+     *          The levels below ::last_level are left untouched, if those were linked otherwise.
+     */
+    void connect_to_entry_(                                       //
+        id_t node_id, vector_view_t vector, level_t target_level, //
+        add_config_t const& config, context_t& context,           //
+        level_t last_level = 0) usearch_noexcept_m {
+
+        node_lock_t new_lock = node_lock_(node_id, context);
+
+        // The first linked node of an empty index has no one to connect to.
+        // If another one got there first, link to it instead.
+        entry_point_t entry = entry_point_();
+        if (entry.level < 0) {
+            if (promote_entry_point_({target_level, node_id}))
+                return;
+            entry = entry_point_();
+        }
+
+        connect_node_across_levels_(node_id, vector, entry.id, entry.level, target_level, config, context, last_level);
+        if (target_level > entry.level)
+            promote_entry_point_({target_level, node_id});
+    }
+
+    /**
+     *  @brief  Packs the entry point into a word with the identifier in the lower six bytes and the level
+     *          in the upper two. Goes through bytes, as the `id_t` may not be a native integer.
+     */
+    static std::uint64_t entry_pack_(entry_point_t entry) noexcept {
+        byte_t bytes[sizeof(std::uint64_t)] = {};
+        std::int16_t level = static_cast<std::int16_t>(entry.level);
+        std::memcpy(bytes, &entry.id, (std::min)(sizeof(id_t), std::size_t(6)));
+        std::memcpy(bytes + 6, &level, sizeof(level));
+        std::uint64_t word;
+        std::memcpy(&word, bytes, sizeof(word));
+        return word;
+    }
+
+    static entry_point_t entry_unpack_(std::uint64_t word) noexcept {
+        byte_t bytes[sizeof(std::uint64_t)];
+        std::memcpy(bytes, &word, sizeof(word));
+        std::int16_t level;
+        entry_point_t entry{};
+        std::memcpy(&entry.id, bytes, (std::min)(sizeof(id_t), std::size_t(6)));
+        std::memcpy(&level, bytes + 6, sizeof(level));
+        entry.level = level;
+        return entry;
+    }
+
+    /**
+     *  @brief  Reads the entry point, lock-free, unless the `id_t` is too wide to be packed.
+     */
+    inline entry_point_t entry_point_() const noexcept { return entry_point_(entry_packed_t{}); }
+    inline entry_point_t entry_point_(std::true_type) const noexcept { return entry_unpack_(entry_.load()); }
+    inline entry_point_t entry_point_(std::false_type) const noexcept {
+        std::unique_lock<std::mutex> lock(entry_mutex_);
+        return entry_wide_;
+    }
+
+    void store_entry_point_(entry_point_t entry) noexcept { store_entry_point_(entry, entry_packed_t{}); }
+    void store_entry_point_(entry_point_t entry, std::true_type) noexcept { entry_.store(entry_pack_(entry)); }
+    void store_entry_point_(entry_point_t entry, std::false_type) noexcept {
+        std::unique_lock<std::mutex> lock(entry_mutex_);
+        entry_wide_ = entry;
+    }
 
-        // From `target_level` down perform proper extensive search
-        for (level_t level = (std::min)(target_level, max_level); level >= 0; --level) {
-            // TODO: Handle out of memory conditions
-            search_to_insert_(closest_id, vector, level, config.expansion, context);
-            closest_id = connect_new_node_(node_id, level, context);
-            reconnect_neighbor_nodes_(node_id, level, context);
-        }
+    /**
+     *  @brief  Replaces the entry point, unless it's already on the same or a higher level.
+     *  @return `true` if the ::candidate became the entry point.
+     */
+    bool promote_entry_point_(entry_point_t candidate) noexcept {
+        return promote_entry_point_(candidate, entry_packed_t{});
+    }
+    bool promote_entry_point_(entry_point_t candidate, std::true_type) noexcept {
+        std::uint64_t desired = entry_pack_(candidate);
+        std::uint64_t expected = entry_.load();
+        while (entry_unpack_(expected).level < candidate.level)
+            if (entry_.compare_exchange_weak(expected, desired))
+                return true;
+        return false;
+    }
+    bool promote_entry_point_(entry_point_t candidate, std::false_type) noexcept {
+        std::unique_lock<std::mutex> lock(entry_mutex_);
+        if (entry_wide_.level >= candidate.level)
+            return false;
+        entry_wide_ = candidate;
+        return true;
     }
 
     id_t connect_new_node_(id_t new_id, level_t level, context_t& context) usearch_noexcept_m {
@@ -3057,53 +5682,303 @@ class index_gt {
         {
             usearch_assert_m(!new_neighbors.size(), "The newly inserted element should have blank link list");
             candidates_view_t top_view = refine_(top, config_.connectivity, context);
+            byte_t* new_distances = neighbors_distances_(new_node, level);
 
+            node_write_t new_write = node_write_(new_id);
             for (std::size_t idx = 0; idx != top_view.size(); idx++) {
                 usearch_assert_m(!new_neighbors[idx], "Possible memory corruption");
                 usearch_assert_m(level <= node_with_id_(top_view[idx].id).level(), "Linking to missing level");
-                new_neighbors.push_back(top_view[idx].id);
+                push_neighbor_(new_neighbors, new_distances, top_view[idx]);
             }
         }
 
         return new_neighbors[0];
     }
 
-    void reconnect_neighbor_nodes_(id_t new_id, level_t level, context_t& context) usearch_noexcept_m {
+    /**
+     *  @brief  Links the base level of ::new_id to the candidates gathered in the successors buffers
+     *          of the ::context, selecting them with the same heuristic as `connect_new_node_`.
+     */
+    void connect_precomputed_(id_t new_id, std::size_t candidates_count, context_t& context) usearch_noexcept_m {
 
         node_t new_node = node_with_id_(new_id);
         top_candidates_t& top = context.top_candidates;
+        top.clear();
+        context.measure_batch(new_node.vector_view(), candidates_count);
+        for (std::size_t idx = 0; idx != candidates_count; ++idx)
+            top.insert_reserved({context.successors_distances[idx], context.successors_ids[idx]});
+
+        candidates_view_t top_view = refine_(top, pre_.connectivity_max_base, context);
+        node_lock_t new_lock = node_lock_(new_id, context);
+        node_write_t new_write = node_write_(new_id);
+        neighbors_ref_t new_neighbors = neighbors_(new_node, 0);
+        byte_t* new_distances = neighbors_distances_(new_node, 0);
+        for (std::size_t idx = 0; idx != top_view.size(); idx++)
+            push_neighbor_(new_neighbors, new_distances, top_view[idx]);
+    }
+
+    void reconnect_neighbor_nodes_(id_t new_id, level_t level, context_t& context) usearch_noexcept_m {
+
+        node_t new_node = node_with_id_(new_id);
         neighbors_ref_t new_neighbors = neighbors_(new_node, level);
+        byte_t* new_distances = neighbors_distances_(new_node, level);
 
         // Reverse links from the neighbors:
+        for (std::size_t new_idx = 0; new_idx != new_neighbors.size(); ++new_idx) {
+            distance_t new_dist = new_distances ? neighbor_distance_(new_distances, new_idx) : distance_t{};
+            link_back_(new_id, new_neighbors[new_idx], new_dist, level, context);
+        }
+    }
+
+    /**
+     *  @brief  Adds a reverse link from ::close_id to ::new_id, pruning the list of ::close_id, if it's full.
+     *          The ::new_dist between them is only used, if the distances are cached, otherwise it's re-measured.
+     */
+    void link_back_(                                                    //
+        id_t new_id, id_t close_id, distance_t new_dist, level_t level, //
+        context_t& context) usearch_noexcept_m {
+
+        node_t new_node = node_with_id_(new_id);
+        top_candidates_t& top = context.top_candidates;
         std::size_t const connectivity_max = level ? config_.connectivity : pre_.connectivity_max_base;
-        for (id_t close_id : new_neighbors) {
-            node_t close_node = node_with_id_(close_id);
-            node_lock_t close_lock = node_lock_(close_id);
-
-            neighbors_ref_t close_header = neighbors_(close_node, level);
-            usearch_assert_m(close_header.size() <= connectivity_max, "Possible corruption");
-            usearch_assert_m(close_id != new_id, "Self-loops are impossible");
-            usearch_assert_m(level <= close_node.level(), "Linking to missing level");
-
-            // If `new_id` is already present in the neighboring connections of `close_id`
-            // then no need to modify any connections or run the heuristics.
-            if (close_header.size() < connectivity_max) {
-                close_header.push_back(new_id);
-                continue;
-            }
+        node_lock_t close_lock = node_lock_(close_id, context);
+        node_t close_node = node_with_id_(close_id);
+        if (close_node.level() < level)
+            return;
+
+        // With cached distances, the saturated lists are pruned without re-measuring the existing links
+        neighbors_ref_t close_header = neighbors_(close_node, level);
+        byte_t* close_distances = neighbors_distances_(close_node, level);
+        usearch_assert_m(close_header.size() <= connectivity_max, "Possible corruption");
+        usearch_assert_m(close_id != new_id, "Self-loops are impossible");
+        usearch_assert_m(level <= close_node.level(), "Linking to missing level");
+
+        // If `new_id` is already present in the neighboring connections of `close_id`
+        // then no need to modify any connections or run the heuristics.
+        for (id_t successor_id : close_header)
+            if (successor_id == new_id)
+                return;
+        if (close_header.size() < connectivity_max) {
+            node_write_t close_write = node_write_(close_id);
+            push_neighbor_(close_header, close_distances, {new_dist, new_id});
+            return;
+        }
 
-            // To fit a new connection we need to drop an existing one.
-            top.clear();
-            usearch_assert_m((top.reserve(close_header.size() + 1)), "The memory must have been reserved in `add`");
+        // To fit a new connection we need to drop an existing one.
+        top.clear();
+        usearch_assert_m((top.reserve(close_header.size() + 1)), "The memory must have been reserved in `add`");
+        if (close_distances) {
+            top.insert_reserved({new_dist, new_id});
+            for (std::size_t idx = 0; idx != close_header.size(); ++idx) {
+                id_t successor_id = close_header[idx];
+                distance_t successor_dist = cached_distance_(close_node, close_distances, idx, successor_id, context);
+                top.insert_reserved({successor_dist, successor_id});
+            }
+        } else {
             top.insert_reserved({context.measure(new_node, close_node), new_id});
-            for (id_t successor_id : close_header)
-                top.insert_reserved({context.measure(node_with_id_(successor_id), close_node), successor_id});
+            std::size_t successors_count = 0;
+            for (id_t successor_id : close_header) {
+                context.successors_ids[successors_count] = successor_id;
+                context.successors_vectors[successors_count] = node_with_id_(successor_id).vector_view();
+                ++successors_count;
+            }
+            context.measure_batch(close_node, successors_count);
+            for (std::size_t idx = 0; idx != successors_count; ++idx)
+                top.insert_reserved({context.successors_distances[idx], context.successors_ids[idx]});
+        }
+
+        // Export the results:
+        candidates_view_t top_view = refine_(top, connectivity_max, context);
+        node_write_t close_write = node_write_(close_id);
+        close_header.clear();
+        for (std::size_t idx = 0; idx != top_view.size(); idx++)
+            push_neighbor_(close_header, close_distances, top_view[idx]);
+    }
+
+    /**
+     *  @brief  Re-selects the neighbors of ::id on a ::level among its current neighbors
+     *          and their neighbors. Only writes into the list of ::id, locking one node at a time.
+     *  @return `false` if run out of memory.
+     */
+    bool refine_neighbors_(                                                        //
+        id_t id, level_t level, std::size_t top_limit, candidate_t* old_neighbors, //
+        std::size_t& replaced, context_t& context) usearch_noexcept_m {
+
+        node_t node = node_with_id_(id);
+        visits_set_t& visits = context.visits;
+        top_candidates_t& top = context.top_candidates;
+        std::size_t const connectivity_max = level ? config_.connectivity : pre_.connectivity_max_base;
+
+        visits.clear();
+        top.clear();
+        if (!visits.set(id))
+            return false;
+
+        // Start with the current neighbors, marking them visited,
+        // so that they aren't measured twice, when reached through each other.
+        std::size_t old_count = 0;
+        {
+            node_lock_t lock = node_lock_(id, context);
+            neighbors_ref_t neighbors = neighbors_(node, level);
+            byte_t* distances = neighbors_distances_(node, level);
+            for (std::size_t idx = 0; idx != neighbors.size(); ++idx)
+                if (!level || node_with_id_(neighbors[idx]).level() >= level)
+                    old_neighbors[old_count++] = {
+                        distances ? cached_distance_(node, distances, idx, neighbors[idx], context) : distance_t{},
+                        neighbors[idx]};
+        }
+        for (std::size_t idx = 0; idx != old_count; ++idx) {
+            if (!visits.set(old_neighbors[idx].id))
+                return false;
+            context.successors_ids[idx] = old_neighbors[idx].id;
+            context.successors_vectors[idx] = node_with_id_(old_neighbors[idx].id).vector_view();
+        }
+        if (!config_.cache_distances) {
+            context.measure_batch(node.vector_view(), old_count);
+            for (std::size_t idx = 0; idx != old_count; ++idx)
+                old_neighbors[idx].distance = context.successors_distances[idx];
+        }
+        for (std::size_t idx = 0; idx != old_count; ++idx)
+            top.insert(candidate_t{old_neighbors[idx]}, top_limit);
+
+        // Pool in the neighbors of neighbors
+        for (std::size_t idx = 0; idx != old_count; ++idx) {
+            id_t neighbor_id = old_neighbors[idx].id;
+            std::size_t successors_count = 0;
+            {
+                node_lock_t lock = node_lock_(neighbor_id, context);
+                for (id_t successor_id : neighbors_(node_with_id_(neighbor_id), level)) {
+                    if (visits.test(successor_id))
+                        continue;
+                    if (level && node_with_id_(successor_id).level() < level)
+                        continue;
+                    if (!visits.set(successor_id))
+                        return false;
+                    context.successors_ids[successors_count] = successor_id;
+                    context.successors_vectors[successors_count] = node_with_id_(successor_id).vector_view();
+                    ++successors_count;
+                }
+            }
+            context.measure_batch(node.vector_view(), successors_count);
+            for (std::size_t jdx = 0; jdx != successors_count; ++jdx)
+                top.insert({context.successors_distances[jdx], context.successors_ids[jdx]}, top_limit);
+            context.iteration_cycles++;
+        }
+
+        // Only rewrite the list, if any of the new links is missing in the old one
+        candidates_view_t top_view = refine_(top, connectivity_max, context);
+        std::size_t added = 0;
+        for (std::size_t idx = 0; idx != top_view.size(); ++idx) {
+            bool existed = false;
+            for (std::size_t jdx = 0; jdx != old_count && !existed; ++jdx)
+                existed = old_neighbors[jdx].id == top_view[idx].id;
+            added += !existed;
+        }
+        if (!added)
+            return true;
+
+        // The heuristic may leave free slots, which we fill with the old links, not to lose the
+        // reverse edges, that `add` has appended without pruning, and with them the connectivity.
+        node_lock_t lock = node_lock_(id, context);
+        node_write_t write = node_write_(id);
+        neighbors_ref_t neighbors = neighbors_(node, level);
+        byte_t* distances = neighbors_distances_(node, level);
+        neighbors.clear();
+        for (std::size_t idx = 0; idx != top_view.size(); ++idx)
+            push_neighbor_(neighbors, distances, top_view[idx]);
+        for (std::size_t idx = 0; idx != old_count && neighbors.size() != connectivity_max; ++idx) {
+            bool kept = false;
+            for (std::size_t jdx = 0; jdx != top_view.size() && !kept; ++jdx)
+                kept = top_view[jdx].id == old_neighbors[idx].id;
+            if (!kept)
+                push_neighbor_(neighbors, distances, old_neighbors[idx]);
+        }
+        replaced += added;
+        return true;
+    }
+
+    /**
+     *  @brief  Searches for a merged node ::id in the graph of members below ::first_id, and re-selects
+     *          its neighbors on every level among the found candidates and its current edges.
+     *          Like `refine_neighbors_`, fills the slots freed by the heuristic with the old links.
+     *          Only the new cross edges are linked back, as the donor graph already had its own.
+     */
+    void merge_node_(                                                                   //
+        id_t id, std::size_t first_id, entry_point_t entry, candidate_t* old_neighbors, //
+        add_config_t const& config, context_t& context) usearch_noexcept_m {
+
+        node_t node = node_with_id_(id);
+        vector_view_t vector = node.vector_view();
+        top_candidates_t& top = context.top_candidates;
+        level_t const node_level = node.level();
+
+        id_t closest_id = search_for_one_(entry.id, vector, entry.level, node_level, config.prefetch_depth, context);
+        for (level_t level = (std::min)(node_level, entry.level); level >= 0; --level) {
+            std::size_t const connectivity_max = level ? config_.connectivity : pre_.connectivity_max_base;
+            search_to_insert_(id, closest_id, vector, level, config.expansion, config.prefetch_depth, context);
+            candidate_t* top_data = top.data();
+            std::size_t top_count = top.size();
+            if (top_count)
+                closest_id = top_data[0].id;
+
+            // Pool in the current edges, that the search hasn't found
+            std::size_t old_count = 0;
+            std::size_t missing_count = 0;
+            {
+                node_lock_t lock = node_lock_(id, context);
+                neighbors_ref_t neighbors = neighbors_(node, level);
+                byte_t* distances = neighbors_distances_(node, level);
+                for (; old_count != neighbors.size(); ++old_count)
+                    old_neighbors[old_count] = {
+                        distances ? cached_distance_(node, distances, old_count, neighbors[old_count], context)
+                                  : distance_t{},
+                        neighbors[old_count]};
+            }
+            for (std::size_t idx = 0; idx != old_count; ++idx) {
+                bool found = false;
+                for (std::size_t jdx = 0; jdx != top_count && !found; ++jdx)
+                    found = top_data[jdx].id == old_neighbors[idx].id;
+                if (found)
+                    continue;
+                if (config_.cache_distances) {
+                    top.insert_reserved(candidate_t{old_neighbors[idx]});
+                    continue;
+                }
+                context.successors_ids[missing_count] = old_neighbors[idx].id;
+                context.successors_vectors[missing_count] = node_with_id_(old_neighbors[idx].id).vector_view();
+                ++missing_count;
+            }
+            context.measure_batch(vector, missing_count);
+            for (std::size_t idx = 0; idx != missing_count; ++idx)
+                top.insert_reserved({context.successors_distances[idx], context.successors_ids[idx]});
 
-            // Export the results:
-            close_header.clear();
             candidates_view_t top_view = refine_(top, connectivity_max, context);
-            for (std::size_t idx = 0; idx != top_view.size(); idx++)
-                close_header.push_back(top_view[idx].id);
+            {
+                node_lock_t lock = node_lock_(id, context);
+                node_write_t write = node_write_(id);
+                neighbors_ref_t neighbors = neighbors_(node, level);
+                byte_t* distances = neighbors_distances_(node, level);
+                neighbors.clear();
+                for (std::size_t idx = 0; idx != top_view.size(); ++idx)
+                    push_neighbor_(neighbors, distances, top_view[idx]);
+                for (std::size_t idx = 0; idx != old_count && neighbors.size() != connectivity_max; ++idx) {
+                    bool kept = false;
+                    for (std::size_t jdx = 0; jdx != top_view.size() && !kept; ++jdx)
+                        kept = top_view[jdx].id == old_neighbors[idx].id;
+                    if (!kept)
+                        push_neighbor_(neighbors, distances, old_neighbors[idx]);
+                }
+            }
+
+            // The reverse links are added without holding the lock of this node, as those prune
+            // the neighbors lists of the others, which may as well be searching through this one.
+            // Those also reuse the `top`, so the cross edges are copied out first.
+            std::size_t cross_count = 0;
+            for (std::size_t idx = 0; idx != top_view.size(); ++idx)
+                if (static_cast<std::size_t>(top_view[idx].id) < first_id)
+                    old_neighbors[cross_count++] = top_view[idx];
+            for (std::size_t idx = 0; idx != cross_count; ++idx)
+                link_back_(id, old_neighbors[idx].id, old_neighbors[idx].distance, level, context);
         }
     }
 
@@ -3113,24 +5988,55 @@ class index_gt {
         return (level_t)r;
     }
 
+    /**
+     *  @brief  Removes the reverse links to an updated node from its old neighbors on the levels
+     *          above the ::new_level, that the new node no longer spans. The links from the other
+     *          nodes may remain, so the traversals skip the neighbors, that are missing the level.
+     */
+    void unlink_dropped_levels_(id_t id, node_t old_node, level_t new_level, context_t& context) noexcept {
+
+        for (level_t level = old_node.level(); level > new_level; --level) {
+            for (id_t neighbor_id : neighbors_(old_node, level)) {
+                node_lock_t neighbor_lock = node_lock_(neighbor_id, context);
+                node_t neighbor = node_with_id_(neighbor_id);
+                if (neighbor.level() < level)
+                    continue;
+
+                // Compacting in place, as every kept link moves only closer to the front
+                node_write_t neighbor_write = node_write_(neighbor_id);
+                neighbors_ref_t neighbors = neighbors_(neighbor, level);
+                byte_t* distances = neighbors_distances_(neighbor, level);
+                std::size_t old_count = neighbors.size();
+                neighbors.clear();
+                for (std::size_t idx = 0; idx != old_count; ++idx)
+                    if (neighbors[idx] != id)
+                        push_neighbor_(neighbors, distances,
+                                       {distances ? neighbor_distance_(distances, idx) : distance_t{}, neighbors[idx]});
+            }
+        }
+    }
+
     id_t search_for_one_(                       //
         id_t closest_id, vector_view_t query,   //
         level_t begin_level, level_t end_level, //
-        context_t& context) const noexcept {
+        std::size_t prefetch_depth, context_t& context) const noexcept {
 
         distance_t closest_dist = context.measure(query, node_with_id_(closest_id));
         for (level_t level = begin_level; level > end_level; --level) {
             bool changed;
             do {
                 changed = false;
-                node_t closest_node = node_with_id_(closest_id);
-                node_lock_t closest_lock = node_lock_(closest_id);
-                neighbors_ref_t closest_neighbors = neighbors_non_base_(closest_node, level);
-                for (id_t candidate_id : closest_neighbors) {
-                    distance_t candidate_dist = context.measure(query, node_with_id_(candidate_id));
-                    if (candidate_dist < closest_dist) {
+                std::size_t candidates_count =
+                    copy_neighbors_non_base_(closest_id, level, context.successors_ids.data());
+                prefetch_neighbors_(context.successors_ids.data(), candidates_count, prefetch_depth);
+                for (std::size_t idx = 0; idx != candidates_count; ++idx)
+                    context.successors_vectors[idx] = node_with_id_(context.successors_ids[idx]).vector_view();
+                context.measure_batch(query, candidates_count);
+                for (std::size_t idx = 0; idx != candidates_count; ++idx) {
+                    distance_t candidate_dist = context.successors_distances[idx];
+                    if (candidate_dist < closest_dist && node_with_id_(context.successors_ids[idx]).level() >= level) {
                         closest_dist = candidate_dist;
-                        closest_id = candidate_id;
+                        closest_id = context.successors_ids[idx];
                         changed = true;
                     }
                 }
@@ -3140,15 +6046,53 @@ class index_gt {
         return closest_id;
     }
 
+    /**
+     *  @brief  Copies the neighbors of a node on an upper ::level into ::ids, without locking
+     *          the node. The copy is repeated, if a concurrent writer has modified the list
+     *          in the meantime. Immutable indexes are read without any synchronization.
+     *  @return The number of copied neighbors.
+     */
+    std::size_t copy_neighbors_non_base_(id_t id, level_t level, id_t* ids) const noexcept {
+
+        if (is_immutable()) {
+            neighbors_ref_t neighbors = neighbors_non_base_(node_with_id_(id), level);
+            std::size_t count = 0;
+            for (id_t neighbor_id : neighbors)
+                ids[count++] = neighbor_id;
+            return count;
+        }
+
+        // The list may be torn by a concurrent writer, so the counter can't be trusted,
+        // until the version is validated. Clamp it to the buffer size to stay in bounds.
+        // An updated node may have been rebuilt with fewer levels, while others still link to it.
+        std::size_t count;
+        typename versions_t::version_t version;
+        do {
+            version = nodes_versions_.read_begin(id);
+            node_t node = node_with_id_(id);
+            if (node.level() < level) {
+                count = 0;
+                continue;
+            }
+            neighbors_ref_t neighbors = neighbors_non_base_(node, level);
+            count = (std::min)(neighbors.size(), config_.connectivity);
+            for (std::size_t idx = 0; idx != count; ++idx)
+                ids[idx] = neighbors[idx];
+        } while (nodes_versions_.read_retry(id, version));
+        return count;
+    }
+
     /**
      *  @brief  Traverses a layer of a graph, to find the best place to insert a new node.
      *          Locks the nodes in the process, assuming other threads are updating neighbors lists.
+     *          Skips the ::new_id itself, as the updated and merged nodes may already be reachable.
      *  @return `true` if procedure succeeded, `false` if run out of memory.
      */
-    bool search_to_insert_( //
-        id_t start_id, vector_view_t query, level_t level, std::size_t top_limit, context_t& context) noexcept {
+    bool search_to_insert_(                                             //
+        id_t new_id, id_t start_id, vector_view_t query, level_t level, //
+        std::size_t top_limit, std::size_t prefetch_depth, context_t& context) noexcept {
 
-        visits_bitset_t& visits = context.visits;
+        visits_set_t& visits = context.visits;
         next_candidates_t& next = context.next_candidates; // pop min, push
         top_candidates_t& top = context.top_candidates;    // pop max, push
 
@@ -3156,10 +6100,13 @@ class index_gt {
         next.clear();
         top.clear();
 
-        distance_t radius = context.measure(query, node_with_id_(start_id));
+        node_t start = node_with_id_(start_id);
+        distance_t radius = context.measure(query, start);
         next.insert_reserved({-radius, start_id});
-        top.insert_reserved({radius, start_id});
-        visits.set(start_id);
+        if (start.level() >= level)
+            top.insert_reserved({radius, start_id});
+        if (!visits.set(start_id) || !visits.set(new_id))
+            return false;
 
         while (!next.empty()) {
 
@@ -3171,18 +6118,22 @@ class index_gt {
             context.iteration_cycles++;
 
             id_t candidate_id = candidacy.id;
+            node_lock_t candidate_lock = node_lock_(candidate_id, context);
             node_t candidate_ref = node_with_id_(candidate_id);
-            node_lock_t candidate_lock = node_lock_(candidate_id);
+            if (candidate_ref.level() < level)
+                continue;
             neighbors_ref_t candidate_neighbors = neighbors_(candidate_ref, level);
 
-            prefetch_neighbors_(candidate_neighbors, visits);
-            for (id_t successor_id : candidate_neighbors) {
-                if (visits.test(successor_id))
+            prefetch_neighbors_(candidate_neighbors, visits, prefetch_depth);
+            std::size_t successors_count = 0;
+            if (!measure_successors_(query, candidate_neighbors, context, successors_count))
+                return false;
+            for (std::size_t idx = 0; idx != successors_count; ++idx) {
+                id_t successor_id = context.successors_ids[idx];
+                distance_t successor_dist = context.successors_distances[idx];
+                if (level && node_with_id_(successor_id).level() < level)
                     continue;
 
-                visits.set(successor_id);
-                distance_t successor_dist = context.measure(query, node_with_id_(successor_id));
-
                 if (top.size() < top_limit || successor_dist < radius) {
                     // This can substantially grow our priority queue:
                     next.insert({-successor_dist, successor_id});
@@ -3201,11 +6152,11 @@ class index_gt {
      *  @return `true` if procedure succeeded, `false` if run out of memory.
      */
     template <typename predicate_at>
-    bool search_to_find_in_base_( //
-        id_t start_id, vector_view_t query, std::size_t expansion, context_t& context,
-        predicate_at&& predicate) const noexcept {
+    bool search_to_find_in_base_(                                  //
+        id_t start_id, vector_view_t query, std::size_t expansion, //
+        std::size_t prefetch_depth, context_t& context, predicate_at&& predicate) const noexcept {
 
-        visits_bitset_t& visits = context.visits;
+        visits_set_t& visits = context.visits;
         next_candidates_t& next = context.next_candidates; // pop min, push
         top_candidates_t& top = context.top_candidates;    // pop max, push
         std::size_t const top_limit = expansion;
@@ -3217,7 +6168,8 @@ class index_gt {
         distance_t radius = context.measure(query, node_with_id_(start_id));
         next.insert_reserved({-radius, start_id});
         top.insert_reserved({radius, start_id});
-        visits.set(start_id);
+        if (!visits.set(start_id))
+            return false;
 
         while (!next.empty()) {
 
@@ -3229,20 +6181,20 @@ class index_gt {
             context.iteration_cycles++;
 
             id_t candidate_id = candidate.id;
-            neighbors_ref_t candidate_neighbors = neighbors_base_(node_with_id_(candidate_id));
-
-            prefetch_neighbors_(candidate_neighbors, visits);
-            for (id_t successor_id : candidate_neighbors) {
-                if (visits.test(successor_id))
-                    continue;
+            neighbors_ref_t candidate_neighbors = neighbors_base_(node_with_id_(candidate_id), context);
 
-                visits.set(successor_id);
-                node_t successor = node_with_id_(successor_id);
-                distance_t successor_dist = context.measure(query, successor);
+            prefetch_neighbors_(candidate_neighbors, visits, prefetch_depth);
+            std::size_t successors_count = 0;
+            if (!measure_successors_(query, candidate_neighbors, context, successors_count))
+                return false;
+            for (std::size_t idx = 0; idx != successors_count; ++idx) {
+                id_t successor_id = context.successors_ids[idx];
+                distance_t successor_dist = context.successors_distances[idx];
 
                 if (top.size() < top_limit || successor_dist < radius) {
                     // This can substantially grow our priority queue:
                     next.insert({-successor_dist, successor_id});
+                    node_t successor = node_with_id_(successor_id);
                     if (predicate( //
                             match_t{member_cref_t{successor.label(), successor.vector_view(), successor_id},
                                     successor_dist})) {
@@ -3257,6 +6209,206 @@ class index_gt {
         return true;
     }
 
+    /**
+     *  @brief  Traverses the @b base layer of a graph, collecting all the matches within ::max_distance
+     *          into `context.range_candidates`. The nodes closer than the `expansion`-th best candidate
+     *          are explored, just like in `search_to_find_in_base_`, but so are all the matches.
+     *  @return `true` if procedure succeeded, `false` if run out of memory.
+     */
+    template <typename predicate_at>
+    bool search_to_find_in_range_(                                                          //
+        id_t start_id, vector_view_t query, distance_t max_distance, std::size_t expansion, //
+        std::size_t prefetch_depth, context_t& context, predicate_at&& predicate) const noexcept {
+
+        visits_set_t& visits = context.visits;
+        next_candidates_t& next = context.next_candidates;     // pop min, push
+        top_candidates_t& top = context.top_candidates;        // pop max, push
+        next_candidates_t& matches = context.range_candidates; // unordered
+        std::size_t const top_limit = expansion;
+
+        visits.clear();
+        next.clear();
+        top.clear();
+
+        distance_t radius = context.measure(query, node_with_id_(start_id));
+        next.insert_reserved({-radius, start_id});
+        top.insert_reserved({radius, start_id});
+        if (!visits.set(start_id))
+            return false;
+        if (radius <= max_distance) {
+            node_t start = node_with_id_(start_id);
+            if (predicate(match_t{member_cref_t{start.label(), start.vector_view(), start_id}, radius}) &&
+                !matches.insert({radius, start_id}))
+                return false;
+        }
+
+        while (!next.empty()) {
+
+            candidate_t candidate = next.top();
+            if ((-candidate.distance) > (std::max)(radius, max_distance))
+                break;
+
+            next.pop();
+            context.iteration_cycles++;
+
+            id_t candidate_id = candidate.id;
+            neighbors_ref_t candidate_neighbors = neighbors_base_(node_with_id_(candidate_id), context);
+
+            prefetch_neighbors_(candidate_neighbors, visits, prefetch_depth);
+            std::size_t successors_count = 0;
+            if (!measure_successors_(query, candidate_neighbors, context, successors_count))
+                return false;
+            for (std::size_t idx = 0; idx != successors_count; ++idx) {
+                id_t successor_id = context.successors_ids[idx];
+                distance_t successor_dist = context.successors_distances[idx];
+
+                bool in_beam = top.size() < top_limit || successor_dist < radius;
+                bool in_range = successor_dist <= max_distance;
+                if (!in_beam && !in_range)
+                    continue;
+
+                // This can substantially grow our priority queue:
+                if (!next.insert({-successor_dist, successor_id}))
+                    return false;
+                if (in_beam) {
+                    // This will automatically evict poor matches:
+                    top.insert({successor_dist, successor_id}, top_limit);
+                    radius = top.top().distance;
+                }
+
+                if (!in_range)
+                    continue;
+                node_t successor = node_with_id_(successor_id);
+                if (predicate( //
+                        match_t{member_cref_t{successor.label(), successor.vector_view(), successor_id},
+                                successor_dist}) &&
+                    !matches.insert({successor_dist, successor_id}))
+                    return false;
+            }
+        }
+
+        return true;
+    }
+
+    /**
+     *  @brief  Assigns a new query to the ::lane, positioning it at the entry point of the graph.
+     */
+    void start_lane_(search_lane_t& lane, std::size_t query_idx, vector_view_t query,
+                     context_t& context) const noexcept {
+        lane.query = query;
+        lane.query_idx = query_idx;
+        entry_point_t entry = entry_point_();
+        lane.closest_id = entry.id;
+        lane.radius = context.measure(query, node_with_id_(entry.id));
+        lane.level = entry.level;
+        lane.in_base = false;
+        lane.active = true;
+        lane.successors_count = 0;
+    }
+
+    /**
+     *  @brief  Evaluates the distances to the neighbors, that were gathered and prefetched by the
+     *          previous `advance_lane_` call, repeating the logic of `search_for_one_` on upper levels
+     *          and of `search_to_find_in_base_` on the base level.
+     */
+    template <typename predicate_at>
+    void evaluate_lane_(search_lane_t& lane, std::size_t expansion, context_t& context,
+                        predicate_at&& predicate) const noexcept {
+
+        std::size_t const count = lane.successors_count;
+        for (std::size_t idx = 0; idx != count; ++idx)
+            context.successors_vectors[idx] = node_with_id_(lane.successors_ids[idx]).vector_view();
+        context.measure_batch(lane.query, count);
+
+        if (!lane.in_base) {
+            bool changed = false;
+            for (std::size_t idx = 0; idx != count; ++idx) {
+                distance_t candidate_dist = context.successors_distances[idx];
+                if (candidate_dist < lane.radius) {
+                    lane.radius = candidate_dist;
+                    lane.closest_id = lane.successors_ids[idx];
+                    changed = true;
+                }
+            }
+            if (!changed)
+                --lane.level;
+            return;
+        }
+
+        for (std::size_t idx = 0; idx != count; ++idx) {
+            id_t successor_id = lane.successors_ids[idx];
+            distance_t successor_dist = context.successors_distances[idx];
+
+            if (lane.top.size() < expansion || successor_dist < lane.radius) {
+                lane.next.insert({-successor_dist, successor_id});
+                node_t successor = node_with_id_(successor_id);
+                if (predicate( //
+                        match_t{member_cref_t{successor.label(), successor.vector_view(), successor_id},
+                                successor_dist})) {
+                    lane.top.insert({successor_dist, successor_id}, expansion);
+                    lane.radius = lane.top.top().distance;
+                }
+            }
+        }
+    }
+
+    /**
+     *  @brief  Gathers the neighbors of the next node to expand into the ::lane and prefetches them.
+     *          Deactivates the lane, once the traversal is over.
+     *  @return `true` if procedure succeeded, `false` if run out of memory.
+     */
+    bool advance_lane_(search_lane_t& lane, std::size_t prefetch_depth, context_t& context) const noexcept {
+
+        id_t* successors_ids = lane.successors_ids.data();
+        lane.successors_count = 0;
+
+        // On upper levels keep descending greedily, until we reach the base.
+        if (!lane.in_base && lane.level > 0) {
+            context.iteration_cycles++;
+            lane.successors_count = copy_neighbors_non_base_(lane.closest_id, lane.level, successors_ids);
+            prefetch_neighbors_(successors_ids, lane.successors_count, prefetch_depth);
+            return true;
+        }
+
+        visits_set_t& visits = lane.visits;
+        if (!lane.in_base) {
+            lane.in_base = true;
+            visits.clear();
+            lane.next.clear();
+            lane.top.clear();
+            lane.next.insert_reserved({-lane.radius, lane.closest_id});
+            lane.top.insert_reserved({lane.radius, lane.closest_id});
+            if (!visits.set(lane.closest_id))
+                return false;
+        }
+
+        // Skip the candidates, that have no unvisited neighbors, as there is nothing to wait for.
+        while (!lane.next.empty()) {
+            candidate_t candidate = lane.next.top();
+            if ((-candidate.distance) > lane.radius)
+                break;
+
+            lane.next.pop();
+            context.iteration_cycles++;
+
+            neighbors_ref_t candidate_neighbors = neighbors_base_(node_with_id_(candidate.id), context);
+            for (id_t successor_id : candidate_neighbors) {
+                if (visits.test(successor_id))
+                    continue;
+                if (!visits.set(successor_id))
+                    return false;
+                successors_ids[lane.successors_count++] = successor_id;
+            }
+            if (lane.successors_count) {
+                prefetch_neighbors_(successors_ids, lane.successors_count, prefetch_depth);
+                return true;
+            }
+        }
+
+        lane.active = false;
+        return true;
+    }
+
     /**
      *  @brief  Iterates through all managed vectors, without actually touching the index.
      */
@@ -3271,13 +6423,97 @@ class index_gt {
         for (std::size_t i = 0; i != size(); ++i) {
             id_t id = static_cast<id_t>(i);
             node_t node = node_with_id_(i);
+            // Reading the labels from tapes breaks the sequential stream of slots for the hardware prefetcher
+            if (vectors_.data && i + exact_prefetch_distance_() < size())
+                prefetch_m(vector_slot_(i + exact_prefetch_distance_()));
             distance_t distance = context.measure(query, node);
             if (predicate(match_t{member_cref_t{node.label(), node.vector_view(), id}, distance}))
                 top.insert(candidate_t{distance, id}, count);
         }
     }
 
-    void prefetch_neighbors_(neighbors_ref_t, visits_bitset_t const&) const noexcept {}
+    /**
+     *  @brief  Collects all the members within ::max_distance into `context.range_candidates`,
+     *          without actually touching the index.
+     *  @return `true` if procedure succeeded, `false` if run out of memory.
+     */
+    template <typename predicate_at>
+    bool search_range_exact_(                                             //
+        vector_view_t query, distance_t max_distance, context_t& context, //
+        predicate_at&& predicate) const noexcept {
+
+        next_candidates_t& matches = context.range_candidates;
+        for (std::size_t i = 0; i != size(); ++i) {
+            id_t id = static_cast<id_t>(i);
+            node_t node = node_with_id_(i);
+            distance_t distance = context.measure(query, node);
+            if (distance > max_distance)
+                continue;
+            if (predicate(match_t{member_cref_t{node.label(), node.vector_view(), id}, distance}) &&
+                !matches.insert({distance, id}))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     *  @brief  Marks the unvisited neighbors as visited, gathering them into the ::context,
+     *          and evaluates the distances from the ::query to all of them in one batch.
+     *          The ::successors_count is exported into `context.successors_ids`
+     *          and `context.successors_distances`.
+     *  @return `true` if procedure succeeded, `false` if run out of memory.
+     */
+    bool measure_successors_(                                               //
+        vector_view_t query, neighbors_ref_t neighbors, context_t& context, //
+        std::size_t& successors_count) const noexcept {
+
+        visits_set_t& visits = context.visits;
+        successors_count = 0;
+        for (id_t successor_id : neighbors) {
+            if (visits.test(successor_id))
+                continue;
+
+            if (!visits.set(successor_id))
+                return false;
+            context.successors_ids[successors_count] = successor_id;
+            context.successors_vectors[successors_count] = node_with_id_(successor_id).vector_view();
+            ++successors_count;
+        }
+        context.measure_batch(query, successors_count);
+        return true;
+    }
+
+    /**
+     *  @brief  Issues software prefetches for the head of the tape and the start of the vector of
+     *          up to `depth` neighbors, that haven't been visited yet. The node handles are loaded
+     *          in a tight loop, so that the out-of-order core can overlap the misses on them.
+     */
+    void prefetch_neighbors_(neighbors_ref_t neighbors, visits_set_t const& visits,
+                             std::size_t depth) const noexcept {
+        for (id_t neighbor_id : neighbors) {
+            if (!depth)
+                break;
+            if (visits.test(neighbor_id))
+                continue;
+            prefetch_node_(node_with_id_(neighbor_id));
+            --depth;
+        }
+    }
+
+    /**
+     *  @brief  Issues software prefetches for up to `depth` of the already gathered neighbors.
+     *          Those are either copied from upper levels, where no visits are tracked, as the greedy
+     *          descent only moves forward, or were already marked as visited by `search_batch`.
+     */
+    void prefetch_neighbors_(id_t const* neighbors, std::size_t count, std::size_t depth) const noexcept {
+        for (std::size_t idx = 0; idx != count && idx != depth; ++idx)
+            prefetch_node_(node_with_id_(neighbors[idx]));
+    }
+
+    inline void prefetch_node_(node_t node) const noexcept {
+        prefetch_m(node.tape());
+        prefetch_m(node.vector());
+    }
 
     /**
      *  @brief  This algorithm from the original paper implements a heuristic,
@@ -3359,6 +6595,7 @@ inline file_head_result_t index_metadata(char const* file_path) noexcept {
     result.bytes_for_graphs = state.bytes_for_graphs;
     result.bytes_for_vectors = state.bytes_for_vectors;
     result.bytes_checksum = state.bytes_checksum;
+    result.flags = state.flags;
     return result;
 }
 
@@ -0,0 +1,271 @@
+#pragma once
+#include <limits> // `std::numeric_limits`
+
+#include <usearch/index_punned_dense.hpp>
+
+namespace unum {
+namespace usearch {
+
+/**
+ *  @brief  Wraps an ::index_punned_dense_gt, that starts with 32-bit identifiers in the neighbors lists
+ *          and migrates to the 40-bit `uint40_t` ones, once the reserved capacity exceeds 4B entries.
+ *          Most indexes never grow that large, and save 20% of the graph memory this way.
+ *
+ *  The migration re-encodes the neighbors lists of the existing graph, instead of rebuilding it,
+ *  but still needs both copies in memory for a moment. The saved files record the width of the
+ *  identifiers, and `load` picks the narrowest one, that fits all the entries in the file.
+ *
+ *  @tparam label_at The type of unique labels to assign to vectors.
+ */
+template <typename label_at = std::int64_t> //
+class index_punned_auto_gt {
+  public:
+    using small_t = index_punned_dense_gt<label_at, std::uint32_t>;
+    using big_t = index_punned_dense_gt<label_at, uint40_t>;
+    using label_t = label_at;
+    using distance_t = punned_distance_t;
+
+    using add_result_t = typename big_t::add_result_t;
+    using labeling_result_t = typename big_t::labeling_result_t;
+    using serialization_result_t = typename big_t::serialization_result_t;
+    using stats_t = typename big_t::stats_t;
+
+  private:
+    small_t small_;
+    /// @brief  Only constructed once switching to the wide identifiers, empty otherwise.
+    big_t big_;
+    bool wide_ = false;
+
+  public:
+    index_punned_auto_gt() = default;
+    index_punned_auto_gt(index_punned_auto_gt&&) = default;
+    index_punned_auto_gt& operator=(index_punned_auto_gt&&) = default;
+
+    /**
+     *  @brief Constructs an instance of ::index_punned_auto_gt with 32-bit identifiers.
+     *  @param[in] dimensions The of dimensions per vector.
+     *  @param[in] metric One of the default supported metric @b kinds for distance measurements.
+     *  @param[in] config The index configuration (optional).
+     *  @param[in] accuracy The scalar kind used for internal representations (optional).
+     *  @param[in] expansion_add The expansion factor for adding vectors (optional).
+     *  @param[in] expansion_search The expansion factor for searching vectors (optional).
+     *  @return An instance of ::index_punned_auto_gt.
+     */
+    static index_punned_auto_gt make(                              //
+        std::size_t dimensions, metric_kind_t metric,              //
+        index_config_t config = {},                                //
+        scalar_kind_t accuracy = scalar_kind_t::f32_k,             //
+        std::size_t expansion_add = default_expansion_add(),       //
+        std::size_t expansion_search = default_expansion_search()) {
+
+        index_punned_auto_gt result;
+        result.small_ = small_t::make(dimensions, metric, config, accuracy, expansion_add, expansion_search);
+        return result;
+    }
+
+    /// @brief  Largest number of entries, that can be addressed with 32-bit identifiers.
+    static constexpr std::size_t small_capacity() noexcept { return std::numeric_limits<std::uint32_t>::max(); }
+
+    /// @brief  Checks if the index has already switched to the 40-bit identifiers.
+    bool wide() const noexcept { return wide_; }
+    std::size_t bytes_per_id() const noexcept { return wide_ ? sizeof(uint40_t) : sizeof(std::uint32_t); }
+
+    std::size_t dimensions() const { return wide_ ? big_.dimensions() : small_.dimensions(); }
+    std::size_t size() const { return wide_ ? big_.size() : small_.size(); }
+    std::size_t capacity() const { return wide_ ? big_.capacity() : small_.capacity(); }
+    std::size_t memory_usage() const { return wide_ ? big_.memory_usage() : small_.memory_usage(); }
+
+    stats_t stats() const {
+        if (wide_)
+            return big_.stats();
+        typename small_t::stats_t small_stats = small_.stats();
+        stats_t result{};
+        result.nodes = small_stats.nodes;
+        result.edges = small_stats.edges;
+        result.max_edges = small_stats.max_edges;
+        result.allocated_bytes = small_stats.allocated_bytes;
+        result.lock_acquisitions = small_stats.lock_acquisitions;
+        result.lock_spins = small_stats.lock_spins;
+        result.page_bytes = small_stats.page_bytes;
+        result.pages_locked = small_stats.pages_locked;
+        return result;
+    }
+
+    /**
+     *  @brief  Reserves memory for the index, switching to the 40-bit identifiers,
+     *          if the ::limits exceed the `small_capacity`.
+     */
+    bool reserve(index_limits_t limits) {
+        if (!wide_ && limits.members > small_capacity())
+            return promote(limits);
+        return wide_ ? big_.reserve(limits) : small_.reserve(limits);
+    }
+
+    /**
+     *  @brief  Switches to the 40-bit identifiers ahead of time, re-encoding the existing graph.
+     *          Not thread-safe, no other calls may run concurrently.
+     *  @return `false` on memory allocation errors, keeping the index unchanged.
+     */
+    bool promote(index_limits_t limits) {
+        if (wide_)
+            return big_.reserve(limits);
+        typename big_t::copy_result_t result = small_.template convert<uint40_t>(limits);
+        if (!result) {
+            result.error = nullptr;
+            return false;
+        }
+        big_ = std::move(result.index);
+        wide_ = true;
+
+        // Release the memory of the narrow index, keeping its configuration for the following `load` calls
+        typename small_t::copy_result_t empty = small_.fork();
+        if (empty)
+            small_ = std::move(empty.index);
+        else
+            empty.error = nullptr;
+        return true;
+    }
+
+    void clear() { wide_ ? big_.clear() : small_.clear(); }
+
+    /// @brief  Inserts a vector, as `index_punned_dense_gt::add` does. Thread-safe.
+    template <typename scalar_at> add_result_t add(label_t label, scalar_at const* vector) {
+        if (wide_)
+            return big_.add(label, vector);
+        typename small_t::add_result_t small_result = small_.add(label, vector);
+        add_result_t result;
+        result.error = std::move(small_result.error);
+        result.new_size = small_result.new_size;
+        result.cycles = small_result.cycles;
+        result.measurements = small_result.measurements;
+        result.lock_acquisitions = small_result.lock_acquisitions;
+        result.lock_spins = small_result.lock_spins;
+        result.id = static_cast<std::uint32_t>(small_result.id);
+        return result;
+    }
+
+    /**
+     *  @brief  Outcome of a search. The layout of the matches in the wrapped indexes depends on the width
+     *          of the identifiers, so those are exported into the buffers of the caller instead.
+     */
+    struct search_result_t {
+        std::size_t count{};
+        std::size_t cycles{};
+        std::size_t measurements{};
+        error_t error{};
+
+        explicit operator bool() const noexcept { return !error; }
+        search_result_t failed(error_t message) noexcept {
+            error = std::move(message);
+            return std::move(*this);
+        }
+
+        inline operator std::size_t() const noexcept { return count; }
+        inline std::size_t size() const noexcept { return count; }
+    };
+
+    /**
+     *  @brief  Searches for the closest vectors, as `index_punned_dense_gt::search` does. Thread-safe.
+     *  @param[out] labels_out Buffer for at least ::wanted labels of the matches.
+     *  @param[out] distances_out Optional buffer for at least ::wanted distances.
+     */
+    template <typename scalar_at>
+    search_result_t search(                                               //
+        scalar_at const* vector, std::size_t wanted, label_t* labels_out, //
+        distance_t* distances_out = nullptr) const {
+        return wide_ ? gather_(big_.search(vector, wanted), labels_out, distances_out)
+                     : gather_(small_.search(vector, wanted), labels_out, distances_out);
+    }
+
+    template <typename scalar_at> bool get(label_t label, scalar_at* vector) const {
+        return wide_ ? big_.get(label, vector) : small_.get(label, vector);
+    }
+
+    bool contains(label_t label) const { return wide_ ? big_.contains(label) : small_.contains(label); }
+
+    labeling_result_t remove(label_t label) {
+        if (wide_)
+            return big_.remove(label);
+        typename small_t::labeling_result_t small_result = small_.remove(label);
+        labeling_result_t result;
+        result.error = std::move(small_result.error);
+        result.completed = small_result.completed;
+        return result;
+    }
+
+    serialization_result_t save(char const* path) const {
+        return wide_ ? big_.save(path) : serialization_(small_.save(path));
+    }
+
+    /**
+     *  @brief  Loads an index saved with either width of identifiers, picking the narrowest one,
+     *          that fits all the entries in the file. The neighbors lists are re-encoded if needed.
+     */
+    serialization_result_t load(char const* path) {
+        serialization_result_t result;
+        file_head_result_t head = index_metadata(path);
+        if (!head)
+            return result.failed(std::move(head.error));
+        if (!switch_(head.size > small_capacity()))
+            return result.failed("Can't allocate the index");
+        return wide_ ? big_.load(path) : serialization_(small_.load(path));
+    }
+
+    /**
+     *  @brief  Memory-maps an index saved with either width of identifiers.
+     *          Those can't be re-encoded in a mapped file, so the width of the file is kept.
+     */
+    serialization_result_t view(char const* path) {
+        serialization_result_t result;
+        file_head_result_t head = index_metadata(path);
+        if (!head)
+            return result.failed(std::move(head.error));
+        if (!switch_(head.bytes_per_id != sizeof(std::uint32_t)))
+            return result.failed("Can't allocate the index");
+        return wide_ ? big_.view(path) : serialization_(small_.view(path));
+    }
+
+  private:
+    /**
+     *  @brief  Empties the index before loading a file, constructing the wide index from the configuration
+     *          of the narrow one, or releasing it, if the file needs the other width of the identifiers.
+     */
+    bool switch_(bool wide) {
+        small_.clear();
+        if (wide_ && wide)
+            big_.clear();
+        else if (wide) {
+            typename big_t::copy_result_t result = small_.template convert<uint40_t>({});
+            if (!result) {
+                result.error = nullptr;
+                return false;
+            }
+            big_ = std::move(result.index);
+        } else
+            big_ = big_t{};
+        wide_ = wide;
+        return true;
+    }
+
+    template <typename result_at>
+    static search_result_t gather_(result_at&& found, label_t* labels_out, distance_t* distances_out) {
+        search_result_t result;
+        if (!found)
+            return result.failed(std::move(found.error));
+        result.count = distances_out ? found.dump_to(labels_out, distances_out) : found.dump_to(labels_out);
+        result.cycles = found.cycles;
+        result.measurements = found.measurements;
+        return result;
+    }
+
+    static serialization_result_t serialization_(typename small_t::serialization_result_t&& small_result) {
+        serialization_result_t result;
+        result.error = std::move(small_result.error);
+        return result;
+    }
+};
+
+using punned_auto_t = index_punned_auto_gt<std::uint64_t>;
+
+} // namespace usearch
+} // namespace unum
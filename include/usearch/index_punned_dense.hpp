@@ -2,6 +2,7 @@
 #include <stdlib.h> // `aligned_alloc`
 
 #include <functional>   // `std::function`
+#include <memory>       // `std::shared_ptr`
 #include <numeric>      // `std::iota`
 #include <shared_mutex> // `std::shared_mutex`
 #include <thread>       // `std::thread`
@@ -17,6 +18,7 @@ namespace usearch {
 
 struct cos_f8_t {
     using scalar_t = f8_bits_t;
+    using view_t = span_gt<scalar_t const>;
     std::size_t dimensions;
 
     inline cos_f8_t(std::size_t dims) noexcept : dimensions(dims) {}
@@ -39,10 +41,63 @@ struct cos_f8_t {
         }
         return (ab != 0) ? (1.f - ab / (std::sqrt(a2) * std::sqrt(b2))) : 0;
     }
+
+    /**
+     *  @brief  Computes the distances from one ::query to ::count ::candidates at once,
+     *          normalizing the query only once and reusing every loaded query scalar
+     *          across a group of four candidates.
+     */
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count,
+                      punned_distance_t* results) const noexcept {
+        f8_bits_t const* a = query.data();
+        std::int32_t a2{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : a2)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+        for (std::size_t i = 0; i != dimensions; i++)
+            a2 += square(std::int16_t(a[i]));
+        float const a_norm = std::sqrt(float(a2));
+
+        auto normalize = [=](std::int32_t ab, std::int32_t b2) -> punned_distance_t {
+            return (ab != 0) ? (1.f - ab / (a_norm * std::sqrt(float(b2)))) : 0;
+        };
+        std::size_t idx = 0;
+        for (; idx + 4 <= count; idx += 4) {
+            f8_bits_t const* b0 = candidates[idx + 0];
+            f8_bits_t const* b1 = candidates[idx + 1];
+            f8_bits_t const* b2 = candidates[idx + 2];
+            f8_bits_t const* b3 = candidates[idx + 3];
+            std::int32_t ab0{}, ab1{}, ab2{}, ab3{};
+            std::int32_t b0_sq{}, b1_sq{}, b2_sq{}, b3_sq{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : ab0, ab1, ab2, ab3, b0_sq, b1_sq, b2_sq, b3_sq)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t i = 0; i != dimensions; i++) {
+                std::int16_t ai{a[i]};
+                std::int16_t b0i{b0[i]}, b1i{b1[i]}, b2i{b2[i]}, b3i{b3[i]};
+                ab0 += ai * b0i, ab1 += ai * b1i, ab2 += ai * b2i, ab3 += ai * b3i;
+                b0_sq += b0i * b0i, b1_sq += b1i * b1i, b2_sq += b2i * b2i, b3_sq += b3i * b3i;
+            }
+            results[idx + 0] = normalize(ab0, b0_sq), results[idx + 1] = normalize(ab1, b1_sq);
+            results[idx + 2] = normalize(ab2, b2_sq), results[idx + 3] = normalize(ab3, b3_sq);
+        }
+        for (; idx != count; ++idx)
+            results[idx] = operator()(a, candidates[idx]);
+    }
 };
 
 struct l2sq_f8_t {
     using scalar_t = f8_bits_t;
+    using view_t = span_gt<scalar_t const>;
     std::size_t dimensions;
 
     inline l2sq_f8_t(std::size_t dims) noexcept : dimensions(dims) {}
@@ -61,6 +116,381 @@ struct l2sq_f8_t {
             ab_deltas_sq += square(std::int16_t(a[i]) - std::int16_t(b[i]));
         return ab_deltas_sq;
     }
+
+    /**
+     *  @brief  Computes the distances from one ::query to ::count ::candidates at once,
+     *          reusing every loaded query scalar across a group of four candidates.
+     */
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count,
+                      punned_distance_t* results) const noexcept {
+        f8_bits_t const* a = query.data();
+        std::size_t idx = 0;
+        for (; idx + 4 <= count; idx += 4) {
+            f8_bits_t const* b0 = candidates[idx + 0];
+            f8_bits_t const* b1 = candidates[idx + 1];
+            f8_bits_t const* b2 = candidates[idx + 2];
+            f8_bits_t const* b3 = candidates[idx + 3];
+            std::int32_t d0{}, d1{}, d2{}, d3{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : d0, d1, d2, d3)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t i = 0; i != dimensions; i++) {
+                std::int16_t ai{a[i]};
+                d0 += square(ai - std::int16_t(b0[i])), d1 += square(ai - std::int16_t(b1[i])), //
+                    d2 += square(ai - std::int16_t(b2[i])), d3 += square(ai - std::int16_t(b3[i]));
+            }
+            results[idx + 0] = d0, results[idx + 1] = d1;
+            results[idx + 2] = d2, results[idx + 3] = d3;
+        }
+        for (; idx != count; ++idx)
+            results[idx] = operator()(a, candidates[idx]);
+    }
+};
+
+/**
+ *  @brief  Widens a down-casted scalar for the asymmetric kernels below.
+ *          The `f8_bits_t` stays in its integer scale, same as in `cos_f8_t` and `l2sq_f8_t`,
+ *          so the distances to `f32_t` queries are comparable with the symmetric ones.
+ */
+inline f32_t widen_scalar(f16_t x) noexcept { return f32_t(x); }
+inline f32_t widen_scalar(f8_bits_t x) noexcept { return f32_t(std::int8_t(x)); }
+inline f32_t widen_scale(f16_t) noexcept { return 1.f; }
+inline f32_t widen_scale(f8_bits_t) noexcept { return f8_bits_t::divisor_k; }
+
+/**
+ *  @brief  Cosine distance from a full-precision `f32_t` query to a down-casted vector,
+ *          comparing the original query directly instead of casting it into ::scalar_at.
+ */
+template <typename scalar_at> struct cos_f32_gt {
+    using scalar_t = scalar_at;
+    using view_t = span_gt<f32_t const>;
+    std::size_t dimensions;
+
+    inline cos_f32_gt(std::size_t dims) noexcept : dimensions(dims) {}
+    inline metric_kind_t kind() const noexcept { return metric_kind_t::cos_k; }
+    inline punned_distance_t operator()(f32_t const* a, scalar_t const* b) const noexcept {
+        f32_t ab{}, a2{}, b2{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : ab, a2, b2)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+        for (std::size_t i = 0; i != dimensions; i++) {
+            f32_t bi = widen_scalar(b[i]);
+            ab += a[i] * bi, a2 += square(a[i]), b2 += square(bi);
+        }
+        return (ab != 0) ? (1.f - ab / (std::sqrt(a2) * std::sqrt(b2))) : 0;
+    }
+
+    /**
+     *  @brief  Computes the distances from one ::query to ::count ::candidates at once,
+     *          normalizing the query only once.
+     */
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count,
+                      punned_distance_t* results) const noexcept {
+        f32_t const* a = query.data();
+        f32_t a2{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : a2)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+        for (std::size_t i = 0; i != dimensions; i++)
+            a2 += square(a[i]);
+        f32_t const a_norm = std::sqrt(a2);
+
+        for (std::size_t idx = 0; idx != count; ++idx) {
+            scalar_t const* b = candidates[idx];
+            f32_t ab{}, b2{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : ab, b2)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+            for (std::size_t i = 0; i != dimensions; i++) {
+                f32_t bi = widen_scalar(b[i]);
+                ab += a[i] * bi, b2 += square(bi);
+            }
+            results[idx] = (ab != 0) ? (1.f - ab / (a_norm * std::sqrt(b2))) : 0;
+        }
+    }
+};
+
+/**
+ *  @brief  Squared Euclidean distance from a full-precision `f32_t` query to a down-casted vector,
+ *          comparing the original query directly instead of casting it into ::scalar_at.
+ */
+template <typename scalar_at> struct l2sq_f32_gt {
+    using scalar_t = scalar_at;
+    using view_t = span_gt<f32_t const>;
+    std::size_t dimensions;
+
+    inline l2sq_f32_gt(std::size_t dims) noexcept : dimensions(dims) {}
+    inline metric_kind_t kind() const noexcept { return metric_kind_t::l2sq_k; }
+    inline punned_distance_t operator()(f32_t const* a, scalar_t const* b) const noexcept {
+        f32_t const scale = widen_scale(scalar_t{});
+        f32_t ab_deltas_sq{};
+#if USEARCH_USE_OPENMP
+#pragma omp simd reduction(+ : ab_deltas_sq)
+#elif defined(USEARCH_DEFINED_CLANG)
+#pragma clang loop vectorize(enable)
+#elif defined(USEARCH_DEFINED_GCC)
+#pragma GCC ivdep
+#endif
+        for (std::size_t i = 0; i != dimensions; i++)
+            ab_deltas_sq += square(a[i] * scale - widen_scalar(b[i]));
+        return ab_deltas_sq;
+    }
+
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count,
+                      punned_distance_t* results) const noexcept {
+        for (std::size_t idx = 0; idx != count; ++idx)
+            results[idx] = operator()(query.data(), candidates[idx]);
+    }
+};
+
+/**
+ *  @brief  Configuration of the Product Quantization, trading accuracy for memory.
+ */
+struct pq_config_t {
+    /// @brief Number of equal slices every vector is split into. Zero means 8 dimensions per slice.
+    std::size_t subspaces = 0;
+    /// @brief Bits per code of every slice: 8 for 256 centroids, or 4 for 16 centroids.
+    std::size_t bits = 8;
+    /// @brief Number of k-means refinement rounds for every slice.
+    std::size_t iterations = 16;
+    /// @brief Seed for the random choice of initial centroids.
+    std::uint64_t seed = 42;
+};
+
+/**
+ *  @brief  Product Quantization codebook. Splits vectors into equal slices, and replaces every
+ *          slice with the ID of the closest centroid, trained with k-means for that slice.
+ *
+ *  Queries are compared with codes using Asymmetric Distance Computation: a per-query table
+ *  holds the distances from every query slice to every centroid of that slice, so that each
+ *  slice of a candidate costs a single lookup. Codes are compared with codes through centroids.
+ *  Cosine distance is evaluated as the inner product of normalized vectors.
+ */
+class pq_codebook_t {
+    metric_kind_t kind_ = metric_kind_t::unknown_k;
+    std::size_t dimensions_ = 0;
+    std::size_t subspaces_ = 0;
+    std::size_t bits_ = 0;
+    /// @brief Centroids of all slices, shaped as `subspaces_` x `centroids()` x `slice_dimensions()`.
+    std::vector<f32_t> centroids_;
+
+  public:
+    pq_codebook_t() = default;
+    pq_codebook_t(metric_kind_t kind, std::size_t dimensions, std::size_t subspaces, std::size_t bits)
+        : kind_(kind), dimensions_(dimensions), subspaces_(subspaces), bits_(bits),
+          centroids_(dimensions * (std::size_t(1) << bits)) {}
+
+    metric_kind_t kind() const noexcept { return kind_; }
+    std::size_t dimensions() const noexcept { return dimensions_; }
+    std::size_t subspaces() const noexcept { return subspaces_; }
+    std::size_t bits() const noexcept { return bits_; }
+    std::size_t centroids() const noexcept { return std::size_t(1) << bits_; }
+    std::size_t slice_dimensions() const noexcept { return dimensions_ / subspaces_; }
+    std::size_t code_bytes() const noexcept { return divide_round_up<CHAR_BIT>(subspaces_ * bits_); }
+    std::size_t table_bytes() const noexcept { return subspaces_ * centroids() * sizeof(f32_t); }
+    std::size_t data_bytes() const noexcept { return centroids_.size() * sizeof(f32_t); }
+    f32_t* data() noexcept { return centroids_.data(); }
+    f32_t const* data() const noexcept { return centroids_.data(); }
+
+    /**
+     *  @brief  Normalizes the ::vector in-place, if the metric is angular.
+     *          Must be applied to every vector before `encode` or `table`.
+     */
+    void prepare(f32_t* vector) const noexcept {
+        if (kind_ != metric_kind_t::cos_k)
+            return;
+        f32_t norm_sq = 0;
+        for (std::size_t i = 0; i != dimensions_; ++i)
+            norm_sq += square(vector[i]);
+        f32_t norm_inv = norm_sq > 0 ? 1.f / std::sqrt(norm_sq) : 0.f;
+        for (std::size_t i = 0; i != dimensions_; ++i)
+            vector[i] *= norm_inv;
+    }
+
+    /**
+     *  @brief  Runs k-means over every slice of the ::vectors sample, which must contain
+     *          at least `centroids()` entries.
+     */
+    void train(f32_t const* vectors, std::size_t count, std::size_t iterations, std::uint64_t seed) {
+        std::vector<f32_t> sample(vectors, vectors + count * dimensions_);
+        for (std::size_t i = 0; i != count; ++i)
+            prepare(sample.data() + i * dimensions_);
+
+        std::mt19937_64 generator(seed);
+        std::size_t const slice = slice_dimensions();
+        std::size_t const k = centroids();
+        std::vector<f32_t> sums(k * slice);
+        std::vector<std::size_t> sizes(k);
+        std::vector<std::size_t> order(count);
+        for (std::size_t subspace = 0; subspace != subspaces_; ++subspace) {
+            f32_t* means = centroids_.data() + subspace * k * slice;
+            auto slice_of = [&](std::size_t i) { return sample.data() + i * dimensions_ + subspace * slice; };
+
+            // Start from distinct random members of the sample
+            std::iota(order.begin(), order.end(), 0ul);
+            for (std::size_t c = 0; c != k; ++c) {
+                std::swap(order[c], order[c + generator() % (count - c)]);
+                std::memcpy(means + c * slice, slice_of(order[c]), slice * sizeof(f32_t));
+            }
+
+            for (std::size_t iteration = 0; iteration != iterations; ++iteration) {
+                std::fill(sums.begin(), sums.end(), 0.f);
+                std::fill(sizes.begin(), sizes.end(), 0ul);
+                for (std::size_t i = 0; i != count; ++i) {
+                    f32_t const* point = slice_of(i);
+                    std::size_t c = closest_(means, point);
+                    for (std::size_t d = 0; d != slice; ++d)
+                        sums[c * slice + d] += point[d];
+                    sizes[c]++;
+                }
+                // Empty clusters are restarted from random points
+                for (std::size_t c = 0; c != k; ++c) {
+                    if (sizes[c])
+                        for (std::size_t d = 0; d != slice; ++d)
+                            means[c * slice + d] = sums[c * slice + d] / sizes[c];
+                    else
+                        std::memcpy(means + c * slice, slice_of(generator() % count), slice * sizeof(f32_t));
+                }
+            }
+        }
+    }
+
+    /// @brief  Replaces every slice of a prepared ::vector with the ID of its closest centroid.
+    void encode(f32_t const* vector, byte_t* codes) const noexcept {
+        std::memset(codes, 0, code_bytes());
+        std::size_t const slice = slice_dimensions();
+        for (std::size_t subspace = 0; subspace != subspaces_; ++subspace) {
+            f32_t const* means = centroids_.data() + subspace * centroids() * slice;
+            std::size_t c = closest_(means, vector + subspace * slice);
+            if (bits_ == 8)
+                codes[subspace] = static_cast<byte_t>(c);
+            else
+                codes[subspace / 2] |= static_cast<byte_t>(c << (4 * (subspace & 1)));
+        }
+    }
+
+    void decode(byte_t const* codes, f32_t* vector) const noexcept {
+        std::size_t const slice = slice_dimensions();
+        for (std::size_t subspace = 0; subspace != subspaces_; ++subspace)
+            std::memcpy(vector + subspace * slice, centroid_(subspace, code_(codes, subspace)),
+                        slice * sizeof(f32_t));
+    }
+
+    /// @brief  Fills the Asymmetric Distance Computation ::table for a prepared ::query.
+    void table(f32_t const* query, f32_t* table) const noexcept {
+        std::size_t const slice = slice_dimensions();
+        for (std::size_t subspace = 0; subspace != subspaces_; ++subspace)
+            for (std::size_t c = 0; c != centroids(); ++c)
+                table[subspace * centroids() + c] = measure_(query + subspace * slice, centroid_(subspace, c));
+    }
+
+    inline punned_distance_t asymmetric(f32_t const* table, byte_t const* codes) const noexcept {
+        unsigned char const* octets = reinterpret_cast<unsigned char const*>(codes);
+        f32_t distance = bias_();
+        if (bits_ == 8) {
+            for (std::size_t subspace = 0; subspace != subspaces_; ++subspace, table += 256)
+                distance += table[octets[subspace]];
+        } else {
+            for (std::size_t pair = 0; pair != subspaces_ / 2; ++pair, table += 32)
+                distance += table[octets[pair] & 15] + table[16 + (octets[pair] >> 4)];
+        }
+        return distance;
+    }
+
+    inline punned_distance_t symmetric(byte_t const* a, byte_t const* b) const noexcept {
+        f32_t distance = bias_();
+        for (std::size_t subspace = 0; subspace != subspaces_; ++subspace)
+            distance += measure_(centroid_(subspace, code_(a, subspace)), centroid_(subspace, code_(b, subspace)));
+        return distance;
+    }
+
+  private:
+    /// @brief  Inner-product distances are `1 - dot`, split into per-slice negative dot-products.
+    f32_t bias_() const noexcept { return kind_ == metric_kind_t::l2sq_k ? 0.f : 1.f; }
+
+    inline f32_t measure_(f32_t const* a, f32_t const* b) const noexcept {
+        std::size_t const slice = slice_dimensions();
+        f32_t result = 0;
+        if (kind_ == metric_kind_t::l2sq_k)
+            for (std::size_t d = 0; d != slice; ++d)
+                result += square(a[d] - b[d]);
+        else
+            for (std::size_t d = 0; d != slice; ++d)
+                result -= a[d] * b[d];
+        return result;
+    }
+
+    inline std::size_t code_(byte_t const* codes, std::size_t subspace) const noexcept {
+        unsigned char const* octets = reinterpret_cast<unsigned char const*>(codes);
+        return bits_ == 8 ? octets[subspace] : (octets[subspace / 2] >> (4 * (subspace & 1))) & 15;
+    }
+
+    inline f32_t const* centroid_(std::size_t subspace, std::size_t c) const noexcept {
+        return centroids_.data() + (subspace * centroids() + c) * slice_dimensions();
+    }
+
+    std::size_t closest_(f32_t const* means, f32_t const* point) const noexcept {
+        std::size_t const slice = slice_dimensions();
+        std::size_t closest = 0;
+        f32_t closest_distance = std::numeric_limits<f32_t>::max();
+        for (std::size_t c = 0; c != centroids(); ++c) {
+            f32_t distance = 0;
+            for (std::size_t d = 0; d != slice; ++d)
+                distance += square(means[c * slice + d] - point[d]);
+            if (distance < closest_distance)
+                closest = c, closest_distance = distance;
+        }
+        return closest;
+    }
+};
+
+/**
+ *  @brief  Compares PQ codes. Distinguishes queries, replaced with distance tables,
+ *          from the stored codes by their length.
+ */
+struct pq_metric_t {
+    using scalar_t = byte_t;
+    using view_t = span_gt<scalar_t const>;
+    std::shared_ptr<pq_codebook_t const> codebook;
+
+    inline metric_kind_t kind() const noexcept { return codebook->kind(); }
+    inline punned_distance_t operator()(view_t a, view_t b) const noexcept {
+        if (a.size() == codebook->table_bytes())
+            return codebook->asymmetric(reinterpret_cast<f32_t const*>(a.data()), b.data());
+        return codebook->symmetric(a.data(), b.data());
+    }
+
+    template <typename candidates_at>
+    inline void batch(view_t query, candidates_at&& candidates, std::size_t count,
+                      punned_distance_t* results) const noexcept {
+        if (query.size() != codebook->table_bytes()) {
+            for (std::size_t idx = 0; idx != count; ++idx)
+                results[idx] = codebook->symmetric(query.data(), candidates[idx]);
+            return;
+        }
+        f32_t const* table = reinterpret_cast<f32_t const*>(query.data());
+        for (std::size_t idx = 0; idx != count; ++idx)
+            results[idx] = codebook->asymmetric(table, candidates[idx]);
+    }
 };
 
 struct index_punned_dense_metric_t {
@@ -68,8 +498,16 @@ struct index_punned_dense_metric_t {
     using result_t = punned_distance_t;
     using view_t = punned_vector_view_t;
     using stl_func_t = std::function<punned_distance_t(punned_vector_view_t, punned_vector_view_t)>;
+    /// @brief Schema: query, candidates, number of candidates, output distances.
+    using stl_batch_func_t = std::function<void(view_t, view_t const*, std::size_t, result_t*)>;
 
     stl_func_t func_;
+    /// @brief Optional one-to-many kernel. If missing, `func_` is called in a loop.
+    stl_batch_func_t batch_func_;
+    /// @brief Optional asymmetric kernels for `f32_t` queries, told apart from stored vectors by their length.
+    stl_func_t f32_query_func_;
+    stl_batch_func_t f32_query_batch_func_;
+    std::size_t f32_query_bytes_ = 0;
     metric_kind_t kind_ = metric_kind_t::unknown_k;
     scalar_kind_t scalar_kind_ = scalar_kind_t::unknown_k;
     isa_t isa_ = isa_t::auto_k;
@@ -90,9 +528,11 @@ struct index_punned_dense_metric_t {
             typed_view_t b_typed{(scalar_t const*)b.data(), dims};
             return metric(a_typed, b_typed);
         };
+        using batched_t = std::integral_constant<bool, has_batch_gt<typed_at, typed_view_t, result_t>::value>;
+        batch_func_ = make_batch_<scalar_t>(metric, batched_t{});
         if (std::is_same<scalar_at, f8_bits_t>())
             scalar_kind_ = scalar_kind_t::f8_k;
-        else if (std::is_same<scalar_at, f16_bits_t>())
+        else if (std::is_same<scalar_at, f16_bits_t>() || std::is_same<scalar_at, f16_native_t>())
             scalar_kind_ = scalar_kind_t::f16_k;
         else
             scalar_kind_ = common_scalar_kind<scalar_at>();
@@ -102,7 +542,75 @@ struct index_punned_dense_metric_t {
 
     inline metric_kind_t kind() const noexcept { return kind_; }
     inline scalar_kind_t scalar_kind() const noexcept { return scalar_kind_; }
-    inline result_t operator()(view_t a, view_t b) const { return func_(a, b); }
+    inline bool accepts_f32_queries() const noexcept { return f32_query_bytes_ != 0; }
+    inline result_t operator()(view_t a, view_t b) const {
+        return f32_query_bytes_ && a.size() == f32_query_bytes_ ? f32_query_func_(a, b) : func_(a, b);
+    }
+
+    /**
+     *  @brief  Evaluates the distances from one ::query to ::count ::candidates,
+     *          paying for the type-erased call only once per batch.
+     */
+    inline void batch(view_t query, view_t const* candidates, std::size_t count, result_t* results) const {
+        if (f32_query_bytes_ && query.size() == f32_query_bytes_)
+            return f32_query_batch_func_(query, candidates, count, results);
+        if (batch_func_)
+            return batch_func_(query, candidates, count, results);
+        for (std::size_t i = 0; i != count; ++i)
+            results[i] = func_(query, candidates[i]);
+    }
+
+    /**
+     *  @brief  Extends the metric with an asymmetric kernel, comparing full-precision `f32_t`
+     *          queries to the stored vectors, without casting the queries into the stored type.
+     *  @tparam typed_at Kernel like `cos_f32_gt`, with a `dimensions` member and a `batch` method.
+     */
+    template <typename typed_at> index_punned_dense_metric_t with_f32_queries(typed_at metric) const {
+        using scalar_t = typename typed_at::scalar_t;
+        struct typed_candidates_t {
+            view_t const* candidates;
+            scalar_t const* operator[](std::size_t i) const noexcept { return (scalar_t const*)candidates[i].data(); }
+        };
+        index_punned_dense_metric_t result = *this;
+        result.f32_query_bytes_ = metric.dimensions * sizeof(f32_t);
+        result.f32_query_func_ = [=](view_t a, view_t b) -> result_t {
+            return metric((f32_t const*)a.data(), (scalar_t const*)b.data());
+        };
+        result.f32_query_batch_func_ = [=](view_t query, view_t const* candidates, std::size_t count,
+                                           result_t* results) {
+            span_gt<f32_t const> query_typed{(f32_t const*)query.data(), metric.dimensions};
+            metric.batch(query_typed, typed_candidates_t{candidates}, count, results);
+        };
+        return result;
+    }
+
+  private:
+    template <typename scalar_at, typename typed_at>
+    static stl_batch_func_t make_batch_(typed_at metric, std::true_type) {
+        using scalar_t = scalar_at;
+        using typed_view_t = span_gt<scalar_t const>;
+        struct typed_candidates_t {
+            view_t const* candidates;
+            scalar_t const* operator[](std::size_t i) const noexcept { return (scalar_t const*)candidates[i].data(); }
+        };
+        return [=](view_t query, view_t const* candidates, std::size_t count, result_t* results) {
+            std::size_t dims = query.size() / sizeof(scalar_t);
+            typed_view_t query_typed{(scalar_t const*)query.data(), dims};
+            metric.batch(query_typed, typed_candidates_t{candidates}, count, results);
+        };
+    }
+
+    template <typename scalar_at, typename typed_at>
+    static stl_batch_func_t make_batch_(typed_at metric, std::false_type) {
+        using scalar_t = scalar_at;
+        using typed_view_t = span_gt<scalar_t const>;
+        return [=](view_t query, view_t const* candidates, std::size_t count, result_t* results) {
+            std::size_t dims = query.size() / sizeof(scalar_t);
+            typed_view_t query_typed{(scalar_t const*)query.data(), dims};
+            for (std::size_t i = 0; i != count; ++i)
+                results[i] = metric(query_typed, typed_view_t{(scalar_t const*)candidates[i].data(), dims});
+        };
+    }
 };
 
 constexpr std::size_t default_removals_cycle() { return 64; }
@@ -125,6 +633,27 @@ label_at default_free_value() {
     return label_at();
 }
 
+/**
+ *  @brief  Conversions of vectors between the supported scalar types and the one used in an index.
+ *          Shared by the indexes with different identifiers, to be copied between those.
+ */
+struct punned_casts_t {
+    /// @brief Schema: input buffer, bytes in input buffer, output buffer.
+    using cast_t = std::function<bool(byte_t const*, std::size_t, byte_t*)>;
+
+    cast_t from_b1x8;
+    cast_t from_f8;
+    cast_t from_f16;
+    cast_t from_f32;
+    cast_t from_f64;
+
+    cast_t to_b1x8;
+    cast_t to_f8;
+    cast_t to_f16;
+    cast_t to_f32;
+    cast_t to_f64;
+};
+
 /**
  *  @brief  Oversimplified type-punned index for equidimensional vectors
  *          with automatic @b down-casting, hardware-specific @b SIMD metrics,
@@ -141,8 +670,8 @@ class index_punned_dense_gt {
     using metric_t = index_punned_dense_metric_t;
 
   private:
-    /// @brief Schema: input buffer, bytes in input buffer, output buffer.
-    using cast_t = std::function<bool(byte_t const*, std::size_t, byte_t*)>;
+    using cast_t = punned_casts_t::cast_t;
+    using casts_t = punned_casts_t;
     /// @brief Punned index.
     using index_t = index_gt<metric_t, label_t, id_t, aligned_allocator_t, memory_mapping_allocator_t>;
     using index_allocator_t = aligned_allocator_gt<index_t, 64>;
@@ -162,22 +691,26 @@ class index_punned_dense_gt {
 
     std::size_t casted_vector_bytes_ = 0;
     mutable std::vector<byte_t> cast_buffer_;
-    struct casts_t {
-        cast_t from_b1x8;
-        cast_t from_f8;
-        cast_t from_f16;
-        cast_t from_f32;
-        cast_t from_f64;
-
-        cast_t to_b1x8;
-        cast_t to_f8;
-        cast_t to_f16;
-        cast_t to_f32;
-        cast_t to_f64;
-    } casts_;
+    casts_t casts_;
 
     metric_t root_metric_;
 
+    /// @brief Conversions between the supported scalar types and `f32_t`.
+    casts_t f32_casts_;
+
+    /// @brief Product Quantization codebook, shared with the metric, if the index stores PQ codes.
+    std::shared_ptr<pq_codebook_t const> pq_;
+    /// @brief Per-thread distance tables, followed by the query in `f32_t`.
+    mutable std::vector<f32_t> pq_buffer_;
+
+    /// @brief Full-precision copies of vectors, used to rerank the matches found with down-casted ones.
+    bool rerank_ = false;
+    metric_t rerank_metric_;
+    mutable std::vector<f32_t> rerank_buffer_;
+    /// @brief Original vectors addressed by IDs, unless those are memory-mapped into `rerank_viewed_`.
+    std::vector<f32_t> rerank_vectors_;
+    f32_t const* rerank_viewed_ = nullptr;
+
     mutable std::vector<std::size_t> available_threads_;
     mutable std::mutex available_threads_mutex_;
 
@@ -194,9 +727,13 @@ class index_punned_dense_gt {
 
   public:
     using search_result_t = typename index_t::search_result_t;
+    using search_batch_result_t = typename index_t::search_batch_result_t;
     using add_result_t = typename index_t::add_result_t;
+    using add_many_result_t = typename index_t::add_many_result_t;
     using serialization_result_t = typename index_t::serialization_result_t;
     using join_result_t = typename index_t::join_result_t;
+    using refine_result_t = typename index_t::refine_result_t;
+    using reorder_result_t = typename index_t::reorder_result_t;
     using stats_t = typename index_t::stats_t;
     using match_t = typename index_t::match_t;
 
@@ -211,6 +748,14 @@ class index_punned_dense_gt {
           cast_buffer_(std::move(other.cast_buffer_)),                 //
           casts_(std::move(other.casts_)),                             //
           root_metric_(std::move(other.root_metric_)),                 //
+          f32_casts_(std::move(other.f32_casts_)),                     //
+          pq_(std::move(other.pq_)),                                   //
+          pq_buffer_(std::move(other.pq_buffer_)),                     //
+          rerank_(std::move(other.rerank_)),                           //
+          rerank_metric_(std::move(other.rerank_metric_)),             //
+          rerank_buffer_(std::move(other.rerank_buffer_)),             //
+          rerank_vectors_(std::move(other.rerank_vectors_)),           //
+          rerank_viewed_(exchange(other.rerank_viewed_, nullptr)),     //
           available_threads_(std::move(other.available_threads_)),     //
           labeled_lookup_(std::move(other.labeled_lookup_)),           //
           free_ids_(std::move(other.free_ids_)),                       //
@@ -235,6 +780,14 @@ class index_punned_dense_gt {
         std::swap(cast_buffer_, other.cast_buffer_);
         std::swap(casts_, other.casts_);
         std::swap(root_metric_, other.root_metric_);
+        std::swap(f32_casts_, other.f32_casts_);
+        std::swap(pq_, other.pq_);
+        std::swap(pq_buffer_, other.pq_buffer_);
+        std::swap(rerank_, other.rerank_);
+        std::swap(rerank_metric_, other.rerank_metric_);
+        std::swap(rerank_buffer_, other.rerank_buffer_);
+        std::swap(rerank_vectors_, other.rerank_vectors_);
+        std::swap(rerank_viewed_, other.rerank_viewed_);
         std::swap(available_threads_, other.available_threads_);
         std::swap(labeled_lookup_, other.labeled_lookup_);
         std::swap(free_ids_, other.free_ids_);
@@ -305,6 +858,8 @@ class index_punned_dense_gt {
     std::size_t connectivity() const { return typed_->connectivity(); }
     std::size_t size() const { return typed_->size() - free_ids_.size(); }
     std::size_t capacity() const { return typed_->capacity(); }
+    /// @brief  Number of removed entries, whose nodes will be reused by the following `add` calls.
+    std::size_t removed_count() const { return free_ids_.size(); }
     std::size_t max_level() const noexcept { return typed_->max_level(); }
     index_config_t const& config() const { return typed_->config(); }
     index_limits_t const& limits() const { return typed_->limits(); }
@@ -314,6 +869,60 @@ class index_punned_dense_gt {
     std::size_t expansion_search() const { return expansion_search_; }
     void change_expansion_add(std::size_t n) { expansion_add_ = n; }
     void change_expansion_search(std::size_t n) { expansion_search_ = n; }
+    bool rerank_enabled() const noexcept { return rerank_; }
+
+    /**
+     *  @brief  Keeps the original vectors in full precision, next to their down-casted copies.
+     *          The graph is still traversed using the compact representations, but the closest
+     *          `expansion` candidates are then reranked with exact `f32_t` distances.
+     *          Must be called on an empty index.
+     *  @return `false` if the index isn't empty or the metric has no full-precision variant.
+     */
+    bool enable_rerank() {
+        if (typed_->size() || !init_rerank_())
+            return false;
+        rerank_vectors_.resize(typed_->capacity() * dimensions_);
+        return true;
+    }
+
+    struct training_result_t {
+        error_t error{};
+
+        explicit operator bool() const noexcept { return !error; }
+        training_result_t failed(error_t message) noexcept {
+            error = std::move(message);
+            return std::move(*this);
+        }
+    };
+
+    /**
+     *  @brief  Trains a Product Quantization codebook on a sample of vectors, and switches
+     *          the index to store compact PQ codes instead of down-casted vectors.
+     *          Must be called on an empty index, using one of `ip`, `cos`, or `l2sq` metrics.
+     *  @param[in] vectors Row-major matrix of ::count sample vectors.
+     *  @param[in] count Number of samples, at least one per centroid.
+     */
+    training_result_t train_pq(f32_t const* vectors, std::size_t count, pq_config_t config = {}) {
+        training_result_t result;
+        metric_kind_t kind = root_metric_.kind();
+        std::size_t subspaces = config.subspaces ? config.subspaces : dimensions_ / 8;
+        if (typed_->size())
+            return result.failed("Can't quantize a non-empty index!");
+        if (kind != metric_kind_t::ip_k && kind != metric_kind_t::cos_k && kind != metric_kind_t::l2sq_k)
+            return result.failed("Only inner product, cosine, and L2 metrics support quantization!");
+        if (config.bits != 8 && config.bits != 4)
+            return result.failed("Codes must be 4 or 8 bits wide!");
+        if (!subspaces || dimensions_ % subspaces || (config.bits == 4 && subspaces % 2))
+            return result.failed("Dimensions must split into an even number of equal subspaces!");
+        if (count < (std::size_t(1) << config.bits))
+            return result.failed("Need at least one sample per centroid!");
+
+        std::shared_ptr<pq_codebook_t> codebook =
+            std::make_shared<pq_codebook_t>(kind, dimensions_, subspaces, config.bits);
+        codebook->train(vectors, count, config.iterations, config.seed);
+        init_pq_(std::move(codebook));
+        return result;
+    }
 
     member_citerator_t cbegin() const { return typed_->cbegin(); }
     member_citerator_t cend() const { return typed_->cend(); }
@@ -322,13 +931,23 @@ class index_punned_dense_gt {
     member_iterator_t begin() { return typed_->begin(); }
     member_iterator_t end() { return typed_->end(); }
 
-    stats_t stats() const { return typed_->stats(); }
+    stats_t stats() const {
+        stats_t result = typed_->stats();
+        if (!typed_->is_immutable()) {
+            memory_pages_stats_t pages = typed_->tape_allocator().pages();
+            result.page_bytes = pages.page_bytes;
+            result.pages_locked = pages.locked;
+        }
+        return result;
+    }
     stats_t stats(std::size_t level) const { return typed_->stats(level); }
 
     std::size_t memory_usage() const {
-        return typed_->memory_usage(0) +                 //
-               typed_->tape_allocator().total_wasted() + //
-               typed_->tape_allocator().total_reserved();
+        return typed_->memory_usage(0) +                   //
+               typed_->tape_allocator().total_wasted() +   //
+               typed_->tape_allocator().total_reserved() + //
+               (pq_ ? pq_->data_bytes() : 0) +             //
+               rerank_vectors_.size() * sizeof(f32_t);
     }
 
     // clang-format off
@@ -344,6 +963,18 @@ class index_punned_dense_gt {
     add_result_t add(label_t label, f32_t const* vector, add_config_t config) { return add_(label, vector, config, casts_.from_f32); }
     add_result_t add(label_t label, f64_t const* vector, add_config_t config) { return add_(label, vector, config, casts_.from_f64); }
 
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t add_many(label_t const* labels, b1x8_t const* vectors, std::size_t count, std::size_t stride, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), nullptr, 0, casts_.from_b1x8); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t add_many(label_t const* labels, f8_bits_t const* vectors, std::size_t count, std::size_t stride, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), nullptr, 0, casts_.from_f8); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t add_many(label_t const* labels, f16_t const* vectors, std::size_t count, std::size_t stride, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), nullptr, 0, casts_.from_f16); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t add_many(label_t const* labels, f32_t const* vectors, std::size_t count, std::size_t stride, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), nullptr, 0, casts_.from_f32); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t add_many(label_t const* labels, f64_t const* vectors, std::size_t count, std::size_t stride, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), nullptr, 0, casts_.from_f64); }
+
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t build_from_graph(label_t const* labels, b1x8_t const* vectors, std::size_t count, std::size_t stride, std::uint32_t const* neighbors, std::size_t neighbors_per_row, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), neighbors, neighbors_per_row, casts_.from_b1x8); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t build_from_graph(label_t const* labels, f8_bits_t const* vectors, std::size_t count, std::size_t stride, std::uint32_t const* neighbors, std::size_t neighbors_per_row, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), neighbors, neighbors_per_row, casts_.from_f8); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t build_from_graph(label_t const* labels, f16_t const* vectors, std::size_t count, std::size_t stride, std::uint32_t const* neighbors, std::size_t neighbors_per_row, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), neighbors, neighbors_per_row, casts_.from_f16); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t build_from_graph(label_t const* labels, f32_t const* vectors, std::size_t count, std::size_t stride, std::uint32_t const* neighbors, std::size_t neighbors_per_row, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), neighbors, neighbors_per_row, casts_.from_f32); }
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t> add_many_result_t build_from_graph(label_t const* labels, f64_t const* vectors, std::size_t count, std::size_t stride, std::uint32_t const* neighbors, std::size_t neighbors_per_row, add_config_t config = {}, executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) { return add_many_(labels, vectors, count, stride, config, std::forward<executor_at>(executor), std::forward<progress_at>(progress), neighbors, neighbors_per_row, casts_.from_f64); }
+
     search_result_t search(b1x8_t const* vector, std::size_t wanted) const { return search_(vector, wanted, casts_.from_b1x8); }
     search_result_t search(f8_bits_t const* vector, std::size_t wanted) const { return search_(vector, wanted, casts_.from_f8); }
     search_result_t search(f16_t const* vector, std::size_t wanted) const { return search_(vector, wanted, casts_.from_f16); }
@@ -356,6 +987,24 @@ class index_punned_dense_gt {
     search_result_t search(f32_t const* vector, std::size_t wanted, search_config_t config) const { return search_(vector, wanted, config, casts_.from_f32); }
     search_result_t search(f64_t const* vector, std::size_t wanted, search_config_t config) const { return search_(vector, wanted, config, casts_.from_f64); }
 
+    search_result_t search_range(b1x8_t const* vector, distance_t max_distance) const { return search_range_(vector, max_distance, casts_.from_b1x8); }
+    search_result_t search_range(f8_bits_t const* vector, distance_t max_distance) const { return search_range_(vector, max_distance, casts_.from_f8); }
+    search_result_t search_range(f16_t const* vector, distance_t max_distance) const { return search_range_(vector, max_distance, casts_.from_f16); }
+    search_result_t search_range(f32_t const* vector, distance_t max_distance) const { return search_range_(vector, max_distance, casts_.from_f32); }
+    search_result_t search_range(f64_t const* vector, distance_t max_distance) const { return search_range_(vector, max_distance, casts_.from_f64); }
+
+    search_result_t search_range(b1x8_t const* vector, distance_t max_distance, search_config_t config) const { return search_range_(vector, max_distance, config, casts_.from_b1x8); }
+    search_result_t search_range(f8_bits_t const* vector, distance_t max_distance, search_config_t config) const { return search_range_(vector, max_distance, config, casts_.from_f8); }
+    search_result_t search_range(f16_t const* vector, distance_t max_distance, search_config_t config) const { return search_range_(vector, max_distance, config, casts_.from_f16); }
+    search_result_t search_range(f32_t const* vector, distance_t max_distance, search_config_t config) const { return search_range_(vector, max_distance, config, casts_.from_f32); }
+    search_result_t search_range(f64_t const* vector, distance_t max_distance, search_config_t config) const { return search_range_(vector, max_distance, config, casts_.from_f64); }
+
+    template <typename callback_at> search_batch_result_t search_batch(b1x8_t const* vectors, std::size_t count, std::size_t stride, std::size_t wanted, callback_at&& callback, search_config_t config = {}) const { return search_batch_(vectors, count, stride, wanted, std::forward<callback_at>(callback), config, casts_.from_b1x8); }
+    template <typename callback_at> search_batch_result_t search_batch(f8_bits_t const* vectors, std::size_t count, std::size_t stride, std::size_t wanted, callback_at&& callback, search_config_t config = {}) const { return search_batch_(vectors, count, stride, wanted, std::forward<callback_at>(callback), config, casts_.from_f8); }
+    template <typename callback_at> search_batch_result_t search_batch(f16_t const* vectors, std::size_t count, std::size_t stride, std::size_t wanted, callback_at&& callback, search_config_t config = {}) const { return search_batch_(vectors, count, stride, wanted, std::forward<callback_at>(callback), config, casts_.from_f16); }
+    template <typename callback_at> search_batch_result_t search_batch(f32_t const* vectors, std::size_t count, std::size_t stride, std::size_t wanted, callback_at&& callback, search_config_t config = {}) const { return search_batch_(vectors, count, stride, wanted, std::forward<callback_at>(callback), config, casts_.from_f32); }
+    template <typename callback_at> search_batch_result_t search_batch(f64_t const* vectors, std::size_t count, std::size_t stride, std::size_t wanted, callback_at&& callback, search_config_t config = {}) const { return search_batch_(vectors, count, stride, wanted, std::forward<callback_at>(callback), config, casts_.from_f64); }
+
     bool get(label_t label, b1x8_t* vector) const { return get_(label, vector, casts_.to_b1x8); }
     bool get(label_t label, f8_bits_t* vector) const { return get_(label, vector, casts_.to_f8); }
     bool get(label_t label, f16_t* vector) const { return get_(label, vector, casts_.to_f16); }
@@ -374,6 +1023,9 @@ class index_punned_dense_gt {
             unique_lock_t lock(labeled_lookup_mutex_);
             labeled_lookup_.reserve(limits.members);
         }
+        if (rerank_ && rerank_vectors_.size() < limits.members * dimensions_)
+            rerank_vectors_.resize(limits.members * dimensions_);
+        reserve_threads_(limits.threads());
         return typed_->reserve(limits);
     }
 
@@ -386,6 +1038,7 @@ class index_punned_dense_gt {
         typed_->clear();
         labeled_lookup_.clear();
         free_ids_.clear();
+        rerank_viewed_ = nullptr;
     }
 
     /**
@@ -393,7 +1046,14 @@ class index_punned_dense_gt {
      *  @param[in] path The path to the file.
      *  @return Outcome descriptor explictly convertable to boolean.
      */
-    serialization_result_t save(char const* path) const { return typed_->save(path); }
+    serialization_result_t save(char const* path) const {
+        serialization_result_t result = typed_->save(path);
+        if (result && pq_)
+            result = save_pq_(path);
+        if (result && rerank_)
+            result = save_rerank_(path);
+        return result;
+    }
 
     /**
      *  @brief Parses the index from file to RAM.
@@ -401,7 +1061,11 @@ class index_punned_dense_gt {
      *  @return Outcome descriptor explictly convertable to boolean.
      */
     serialization_result_t load(char const* path) {
-        serialization_result_t result = typed_->load(path);
+        serialization_result_t result = load_pq_(path);
+        if (result)
+            result = typed_->load(path);
+        if (result)
+            result = load_rerank_(path);
         if (result)
             reindex_labels_();
         return result;
@@ -413,7 +1077,11 @@ class index_punned_dense_gt {
      *  @return Outcome descriptor explictly convertable to boolean.
      */
     serialization_result_t view(char const* path) {
-        serialization_result_t result = typed_->view(path);
+        serialization_result_t result = load_pq_(path);
+        if (result)
+            result = typed_->view(path);
+        if (result)
+            result = view_rerank_();
         if (result)
             reindex_labels_();
         return result;
@@ -616,6 +1284,14 @@ class index_punned_dense_gt {
 
         result.index.labeled_lookup_ = labeled_lookup_;
         *result.index.typed_ = std::move(typed_result.index);
+        if (rerank_) {
+            std::size_t rerank_scalars = typed_->size() * dimensions_;
+            f32_t const* rerank_begin = rerank_vector_(0);
+            result.index.rerank_vectors_.assign(rerank_begin, rerank_begin + rerank_scalars);
+        }
+        // The copy keeps the capacity of the original, so the following insertions need room for their vectors
+        if (!result.index.reserve(limits()))
+            return result.failed("Out of memory!");
         return result;
     }
 
@@ -625,25 +1301,37 @@ class index_punned_dense_gt {
      */
     copy_result_t fork() const {
         copy_result_t result;
-        index_punned_dense_gt& other = result.index;
-
-        other.dimensions_ = dimensions_;
-        other.scalar_words_ = scalar_words_;
-        other.expansion_add_ = expansion_add_;
-        other.expansion_search_ = expansion_search_;
-        other.casted_vector_bytes_ = casted_vector_bytes_;
-        other.cast_buffer_ = cast_buffer_;
-        other.casts_ = casts_;
-
-        other.root_metric_ = root_metric_;
-        other.available_threads_ = available_threads_;
+        if (!fork_into_(result.index))
+            return result.failed("Can't allocate the index");
+        return result;
+    }
 
-        index_t* raw = index_allocator_t{}.allocate(1);
-        if (!raw)
+    /**
+     *  @brief Copies the ::index_punned_dense_gt @b with all the data into one with other identifiers,
+     *         like `uint40_t` ones for indexes outgrowing 4B entries, without rebuilding the graph.
+     *  @param limits The capacity to reserve in the new index.
+     *  @return A copy of the ::index_punned_dense_gt instance with ::other_id_at identifiers.
+     */
+    template <typename other_id_at>
+    typename index_punned_dense_gt<label_t, other_id_at>::copy_result_t convert(index_limits_t limits) const {
+        using other_t = index_punned_dense_gt<label_t, other_id_at>;
+        typename other_t::copy_result_t result;
+        other_t& other = result.index;
+        if (!fork_into_(other))
             return result.failed("Can't allocate the index");
+        limits.members = (std::max)(limits.members, typed_->size());
+        auto typed_result = other.typed_->convert(*typed_, limits);
+        if (!typed_result)
+            return result.failed(std::move(typed_result.error));
 
-        new (raw) index_t(config(), root_metric_);
-        other.typed_ = raw;
+        other.reindex_labels_();
+        if (rerank_) {
+            std::size_t rerank_scalars = typed_->size() * dimensions_;
+            f32_t const* rerank_begin = rerank_vector_(0);
+            other.rerank_vectors_.assign(rerank_begin, rerank_begin + rerank_scalars);
+        }
+        if (!other.reserve(limits))
+            return result.failed("Out of memory!");
         return result;
     }
 
@@ -680,7 +1368,112 @@ class index_punned_dense_gt {
         return result;
     }
 
+    /**
+     *  @brief Improves the links of an already constructed graph, re-selecting them among neighbors of neighbors.
+     *  @param executor The executor parallel processing. Default ::dummy_executor_t single-threaded.
+     *  @param progress The progress tracker instance to use. Default ::dummy_progress_t reports nothing.
+     */
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t>
+    refine_result_t refine_graph(executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) {
+        return typed_->refine_graph(std::forward<executor_at>(executor), std::forward<progress_at>(progress));
+    }
+
+    /**
+     *  @brief Renumbers the entries in the traversal order of the graph, for better locality. Not thread-safe.
+     *  @param executor The executor parallel processing. Default ::dummy_executor_t single-threaded.
+     *  @param progress The progress tracker instance to use. Default ::dummy_progress_t reports nothing.
+     */
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t>
+    reorder_result_t reorder(executor_at&& executor = executor_at{}, progress_at&& progress = progress_at{}) {
+        // The full-precision copies are addressed by IDs, so they have to follow the nodes
+        std::vector<f32_t> rerank_vectors(rerank_ ? rerank_vectors_.size() : 0);
+        auto relocated = [&](id_t old_id, id_t new_id) {
+            if (rerank_)
+                std::memcpy(rerank_vectors.data() + new_id * dimensions_, rerank_vector_(old_id),
+                            dimensions_ * sizeof(f32_t));
+        };
+        reorder_result_t result =
+            typed_->reorder(relocated, std::forward<executor_at>(executor), std::forward<progress_at>(progress));
+        if (!result)
+            return result;
+        if (rerank_)
+            rerank_vectors_.swap(rerank_vectors);
+        reindex_labels_();
+        return result;
+    }
+
+    /**
+     *  @brief  Appends all the entries of another index, reusing its graph, instead of re-inserting them.
+     *          Both must have the same dimensions, scalar type, metric and connectivity. Not thread-safe.
+     *          If both contain the same label, the lookups will resolve it to the older entry.
+     *  @param other The donor index, that can be discarded afterwards.
+     *  @param executor The executor parallel processing. Default ::dummy_executor_t single-threaded.
+     *  @param progress The progress tracker instance to use. Default ::dummy_progress_t reports nothing.
+     */
+    template <typename executor_at = dummy_executor_t, typename progress_at = dummy_progress_t>
+    add_many_result_t merge(                    //
+        index_punned_dense_gt const& other,     //
+        add_config_t config = {},               //
+        executor_at&& executor = executor_at{}, //
+        progress_at&& progress = progress_at{}) {
+
+        add_many_result_t result;
+        if (other.dimensions_ != dimensions_ || other.root_metric_.scalar_kind() != root_metric_.scalar_kind() ||
+            other.pq_ != pq_)
+            return result.failed("Can only merge indexes with the same vectors representation!");
+        if (other.root_metric_.kind() != root_metric_.kind())
+            return result.failed("Can only merge indexes with the same metric!");
+        if (rerank_ && !other.rerank_)
+            return result.failed("Can't rerank the merged entries without their original vectors!");
+
+        result = typed_->merge(*other.typed_, config, executor, progress);
+        if (!result)
+            return result;
+        if (rerank_)
+            for (std::size_t i = 0; i != other.typed_->size(); ++i)
+                std::memcpy(rerank_vectors_.data() + (static_cast<std::size_t>(result.first_id) + i) * dimensions_,
+                            other.rerank_vector_(i), dimensions_ * sizeof(f32_t));
+        reindex_labels_();
+        return result;
+    }
+
   private:
+    /// @brief  Indexes with other identifiers are populated directly in `convert`.
+    template <typename, typename> friend class index_punned_dense_gt;
+
+    /**
+     *  @brief  Configures an empty ::other index like this one, even if it has different identifiers.
+     *  @return `false` on memory allocation errors.
+     */
+    template <typename other_at> bool fork_into_(other_at& other) const {
+        other.dimensions_ = dimensions_;
+        other.scalar_words_ = scalar_words_;
+        other.expansion_add_ = expansion_add_;
+        other.expansion_search_ = expansion_search_;
+        other.casted_vector_bytes_ = casted_vector_bytes_;
+        other.cast_buffer_ = cast_buffer_;
+        other.casts_ = casts_;
+
+        other.root_metric_ = root_metric_;
+        other.f32_casts_ = f32_casts_;
+        other.pq_ = pq_;
+        other.pq_buffer_ = pq_buffer_;
+        other.rerank_ = rerank_;
+        other.rerank_metric_ = rerank_metric_;
+        other.rerank_buffer_ = rerank_buffer_;
+        other.available_threads_ = available_threads_;
+        other.free_label_ = free_label_;
+
+        using other_index_t = typename other_at::index_t;
+        other_index_t* raw = typename other_at::index_allocator_t{}.allocate(1);
+        if (!raw)
+            return false;
+
+        new (raw) other_index_t(config(), root_metric_, {}, memory_mapping_allocator_t(config().pages));
+        other.typed_ = raw;
+        return true;
+    }
+
     struct thread_lock_t {
         index_punned_dense_gt const& parent;
         std::size_t thread_id;
@@ -708,7 +1501,8 @@ class index_punned_dense_gt {
         std::size_t vector_bytes = dimensions_ * sizeof(scalar_at);
 
         byte_t* casted_data = cast_buffer_.data() + casted_vector_bytes_ * config.thread;
-        bool casted = cast(vector_data, dimensions_, casted_data);
+        bool casted = pq_ ? pq_encode_(vector, casted_data, config.thread)
+                          : cast(vector_data, dimensions_, casted_data);
         if (casted)
             vector_data = casted_data, vector_bytes = casted_vector_bytes_, config.store_vector = true;
 
@@ -719,11 +1513,23 @@ class index_punned_dense_gt {
             free_ids_.try_pop(free_id);
         }
 
+        // The original is stored before the node is linked, so that searches never rerank it against
+        // a stale copy. The reused identifier is known upfront, the new one only once it's reserved.
+        auto store_original = [&](id_t id) {
+            if (!rerank_)
+                return;
+            f32_t* original = rerank_vectors_.data() + static_cast<std::size_t>(id) * dimensions_;
+            if (!f32_from_(vector)(reinterpret_cast<byte_t const*>(vector), dimensions_, (byte_t*)original))
+                std::memcpy(original, vector, dimensions_ * sizeof(f32_t));
+        };
+
         // Perform the insertion or the update
-        add_result_t result =                     //
-            free_id != default_free_value<id_t>() //
-                ? typed_->update(free_id, label, {vector_data, vector_bytes}, config)
-                : typed_->add(label, {vector_data, vector_bytes}, config);
+        add_result_t result;
+        if (free_id != default_free_value<id_t>()) {
+            store_original(free_id);
+            result = typed_->update(free_id, label, {vector_data, vector_bytes}, config);
+        } else
+            result = typed_->add(label, {vector_data, vector_bytes}, config, store_original);
         {
             unique_lock_t lock(labeled_lookup_mutex_);
             labeled_lookup_.emplace(label, result.id);
@@ -731,6 +1537,75 @@ class index_punned_dense_gt {
         return result;
     }
 
+    /// @brief  Checks if the metric has an asymmetric kernel for such queries, so they don't need casting.
+    template <typename scalar_at> bool compares_as_is_(scalar_at const*) const noexcept {
+        return std::is_same<scalar_at, f32_t>::value && root_metric_.accepts_f32_queries();
+    }
+
+    /**
+     *  @param stride Number of bytes between the starts of consecutive vectors.
+     *  @param neighbors Optional row-major kNN graph of the inputs, to build an empty index from.
+     */
+    template <typename scalar_at, typename executor_at, typename progress_at>
+    add_many_result_t add_many_(                                                                //
+        label_t const* labels, scalar_at const* vectors, std::size_t count, std::size_t stride, //
+        add_config_t config, executor_at&& executor, progress_at&& progress,                    //
+        std::uint32_t const* neighbors, std::size_t neighbors_per_row, cast_t const& cast) {
+
+        // The encoding pass below already uses the per-thread buffers, so the executor is checked upfront
+        if (executor.size() > limits().threads()) {
+            add_many_result_t result;
+            return result.failed("Executor has more threads than the index has contexts!");
+        }
+
+        strided_queries_t inputs{reinterpret_cast<byte_t const*>(vectors), stride, dimensions_ * sizeof(scalar_at)};
+
+        // Nodes are allocated for the whole batch at once, so the vectors can't share the per-thread
+        // casting buffer. Like in `search_batch_`, the whole batch is casted upfront, if needed at all.
+        std::vector<byte_t> casted_vectors;
+        if (pq_) {
+            casted_vectors.resize(count * casted_vector_bytes_);
+            executor.execute_bulk(count, [&](std::size_t thread_idx, std::size_t i) {
+                scalar_at const* vector = (scalar_at const*)(inputs.data + i * stride);
+                pq_encode_(vector, casted_vectors.data() + i * casted_vector_bytes_, thread_idx);
+            });
+            inputs = {casted_vectors.data(), casted_vector_bytes_, casted_vector_bytes_};
+            config.store_vector = true;
+        } else if (count && cast(inputs.data, dimensions_, cast_buffer_.data())) {
+            casted_vectors.resize(count * casted_vector_bytes_);
+            executor.execute_bulk(count, [&](std::size_t, std::size_t i) {
+                cast(inputs.data + i * stride, dimensions_, casted_vectors.data() + i * casted_vector_bytes_);
+            });
+            inputs = {casted_vectors.data(), casted_vector_bytes_, casted_vector_bytes_};
+            config.store_vector = true;
+        }
+
+        // Removed entries aren't reused, all the new members are appended. Bulk insertions don't run
+        // concurrently with the others, so the identifiers are known upfront, and the originals are
+        // stored before the nodes are linked, so that searches never rerank those against stale copies.
+        std::size_t first_id = typed_->size();
+        if (rerank_ && (first_id + count) * dimensions_ <= rerank_vectors_.size())
+            executor.execute_bulk(count, [&](std::size_t, std::size_t i) {
+                scalar_at const* vector = (scalar_at const*)((byte_t const*)vectors + i * stride);
+                f32_t* original = rerank_vectors_.data() + (first_id + i) * dimensions_;
+                if (!f32_from_(vector)(reinterpret_cast<byte_t const*>(vector), dimensions_, (byte_t*)original))
+                    std::memcpy(original, vector, dimensions_ * sizeof(f32_t));
+            });
+
+        add_many_result_t result =
+            neighbors ? typed_->build_from_graph(labels, inputs, count, neighbors, neighbors_per_row, config, executor,
+                                                 progress)
+                      : typed_->add_many(labels, inputs, count, config, executor, progress);
+        if (!result)
+            return result;
+        {
+            unique_lock_t lock(labeled_lookup_mutex_);
+            for (std::size_t i = 0; i != count; ++i)
+                labeled_lookup_.emplace(labels[i], static_cast<id_t>(static_cast<std::size_t>(result.first_id) + i));
+        }
+        return result;
+    }
+
     template <typename scalar_at>
     search_result_t search_(                         //
         scalar_at const* vector, std::size_t wanted, //
@@ -740,12 +1615,117 @@ class index_punned_dense_gt {
         std::size_t vector_bytes = dimensions_ * sizeof(scalar_at);
 
         byte_t* casted_data = cast_buffer_.data() + casted_vector_bytes_ * config.thread;
-        bool casted = cast(vector_data, dimensions_, casted_data);
-        if (casted)
+        if (pq_)
+            vector_data = pq_table_(vector, config.thread), vector_bytes = pq_->table_bytes();
+        else if (!compares_as_is_(vector) && cast(vector_data, dimensions_, casted_data))
             vector_data = casted_data, vector_bytes = casted_vector_bytes_;
 
         auto allow = [=](match_t const& match) noexcept { return match.member.label != free_label_; };
-        return typed_->search({vector_data, vector_bytes}, wanted, config, allow);
+        if (!rerank_)
+            return typed_->search({vector_data, vector_bytes}, wanted, config, allow);
+
+        f32_t const* original = rerank_query_(vector, rerank_buffer_.data() + dimensions_ * config.thread);
+        std::size_t candidates = (std::max)(wanted, config.expansion);
+        search_result_t result = typed_->search({vector_data, vector_bytes}, candidates, config, allow);
+        if (result)
+            rerank_matches_(result, original, wanted);
+        return result;
+    }
+
+    template <typename scalar_at>
+    search_result_t search_range_(                        //
+        scalar_at const* vector, distance_t max_distance, //
+        search_config_t config, cast_t const& cast) const {
+
+        byte_t const* vector_data = reinterpret_cast<byte_t const*>(vector);
+        std::size_t vector_bytes = dimensions_ * sizeof(scalar_at);
+
+        byte_t* casted_data = cast_buffer_.data() + casted_vector_bytes_ * config.thread;
+        if (pq_)
+            vector_data = pq_table_(vector, config.thread), vector_bytes = pq_->table_bytes();
+        else if (!compares_as_is_(vector) && cast(vector_data, dimensions_, casted_data))
+            vector_data = casted_data, vector_bytes = casted_vector_bytes_;
+
+        auto allow = [=](match_t const& match) noexcept { return match.member.label != free_label_; };
+        if (!rerank_)
+            return typed_->search_range({vector_data, vector_bytes}, max_distance, config, allow);
+
+        // Distances between compact representations are on a different scale, so the radius
+        // can only be applied after reranking. The number of candidates keeps doubling, until
+        // the farthest reranked one falls out of the range, or the index runs out of members.
+        f32_t const* original = rerank_query_(vector, rerank_buffer_.data() + dimensions_ * config.thread);
+        std::size_t candidates = (std::max)(config.expansion, std::size_t(1));
+        while (true) {
+            search_result_t result = typed_->search({vector_data, vector_bytes}, candidates, config, allow);
+            if (!result)
+                return result;
+            rerank_matches_(result, original, result.size());
+            bool exhausted = result.size() < candidates;
+            if (!exhausted && result[result.size() - 1].distance <= max_distance) {
+                candidates *= 2;
+                continue;
+            }
+            while (result.count && result[result.count - 1].distance > max_distance)
+                --result.count;
+            return result;
+        }
+    }
+
+    /// @brief  Random-access view over a strided matrix of queries, passed to `index_t::search_batch`.
+    struct strided_queries_t {
+        byte_t const* data;
+        std::size_t stride;
+        std::size_t bytes;
+
+        punned_vector_view_t operator[](std::size_t i) const noexcept { return {data + i * stride, bytes}; }
+    };
+
+    /**
+     *  @param stride Number of bytes between the starts of consecutive queries.
+     */
+    template <typename scalar_at, typename callback_at>
+    search_batch_result_t search_batch_(                                                     //
+        scalar_at const* vectors, std::size_t count, std::size_t stride, std::size_t wanted, //
+        callback_at&& callback, search_config_t config, cast_t const& cast) const {
+
+        strided_queries_t queries{reinterpret_cast<byte_t const*>(vectors), stride, dimensions_ * sizeof(scalar_at)};
+
+        // All the interleaved queries are alive at once, so they can't share the per-thread
+        // casting buffer. Instead, the whole batch is casted upfront, if needed at all.
+        std::vector<byte_t> casted_queries;
+        byte_t* casted_data = cast_buffer_.data() + casted_vector_bytes_ * config.thread;
+        if (pq_) {
+            std::size_t table_bytes = pq_->table_bytes();
+            casted_queries.resize(count * table_bytes);
+            for (std::size_t i = 0; i != count; ++i) {
+                scalar_at const* vector = (scalar_at const*)(queries.data + i * stride);
+                std::memcpy(casted_queries.data() + i * table_bytes, pq_table_(vector, config.thread), table_bytes);
+            }
+            queries = {casted_queries.data(), table_bytes, table_bytes};
+        } else if (count && !compares_as_is_(vectors) && cast(queries.data, dimensions_, casted_data)) {
+            casted_queries.resize(count * casted_vector_bytes_);
+            for (std::size_t i = 0; i != count; ++i)
+                cast(queries.data + i * stride, dimensions_, casted_queries.data() + i * casted_vector_bytes_);
+            queries = {casted_queries.data(), casted_vector_bytes_, casted_vector_bytes_};
+        }
+
+        auto allow = [=](match_t const& match) noexcept { return match.member.label != free_label_; };
+        if (!rerank_)
+            return typed_->search_batch(queries, count, wanted, std::forward<callback_at>(callback), config, allow);
+
+        std::vector<f32_t> originals(count * dimensions_);
+        for (std::size_t i = 0; i != count; ++i) {
+            scalar_at const* vector = (scalar_at const*)((byte_t const*)vectors + i * stride);
+            f32_t* original = originals.data() + i * dimensions_;
+            if (rerank_query_(vector, original) != original)
+                std::memcpy(original, vector, dimensions_ * sizeof(f32_t));
+        }
+        auto rerank_callback = [&](std::size_t query_idx, search_result_t& result) {
+            rerank_matches_(result, originals.data() + query_idx * dimensions_, wanted);
+            callback(query_idx, result);
+        };
+        std::size_t candidates = (std::max)(wanted, config.expansion);
+        return typed_->search_batch(queries, count, candidates, rerank_callback, config, allow);
     }
 
     id_t lookup_id_(label_t label) const {
@@ -787,8 +1767,22 @@ class index_punned_dense_gt {
                 return false;
             id = it->second;
         }
+        // Export the original, if it's available
+        if (rerank_) {
+            f32_t const* original = rerank_vector_(id);
+            if (!f32_to_(reconstructed)((byte_t const*)original, dimensions_, (byte_t*)reconstructed))
+                std::memcpy(reconstructed, original, dimensions_ * sizeof(f32_t));
+            return true;
+        }
         // Export the entry
         member_cref_t member = typed_->at(id);
+        if (pq_) {
+            std::vector<f32_t> decoded(dimensions_);
+            pq_->decode(reinterpret_cast<byte_t const*>(member.vector.data()), decoded.data());
+            if (!f32_to_(reconstructed)((byte_t const*)decoded.data(), dimensions_, (byte_t*)reconstructed))
+                std::memcpy(reconstructed, decoded.data(), dimensions_ * sizeof(f32_t));
+            return true;
+        }
         byte_t const* punned_vector = reinterpret_cast<byte_t const*>(member.vector.data());
         bool casted = cast(punned_vector, dimensions_, (byte_t*)reconstructed);
         if (!casted)
@@ -813,6 +1807,296 @@ class index_punned_dense_gt {
         return search_(vector, wanted, search_config, cast);
     }
 
+    template <typename scalar_at>
+    search_result_t search_range_(                        //
+        scalar_at const* vector, distance_t max_distance, //
+        cast_t const& cast) const {
+        thread_lock_t lock = thread_lock_();
+        search_config_t search_config;
+        search_config.thread = lock.thread_id;
+        return search_range_(vector, max_distance, search_config, cast);
+    }
+
+    // clang-format off
+    cast_t const& f32_from_(b1x8_t const*) const noexcept { return f32_casts_.from_b1x8; }
+    cast_t const& f32_from_(f8_bits_t const*) const noexcept { return f32_casts_.from_f8; }
+    cast_t const& f32_from_(f16_t const*) const noexcept { return f32_casts_.from_f16; }
+    cast_t const& f32_from_(f32_t const*) const noexcept { return f32_casts_.from_f32; }
+    cast_t const& f32_from_(f64_t const*) const noexcept { return f32_casts_.from_f64; }
+
+    cast_t const& f32_to_(b1x8_t*) const noexcept { return f32_casts_.to_b1x8; }
+    cast_t const& f32_to_(f8_bits_t*) const noexcept { return f32_casts_.to_f8; }
+    cast_t const& f32_to_(f16_t*) const noexcept { return f32_casts_.to_f16; }
+    cast_t const& f32_to_(f32_t*) const noexcept { return f32_casts_.to_f32; }
+    cast_t const& f32_to_(f64_t*) const noexcept { return f32_casts_.to_f64; }
+    // clang-format on
+
+    f32_t const* rerank_vector_(std::size_t id) const noexcept {
+        return (rerank_viewed_ ? rerank_viewed_ : rerank_vectors_.data()) + id * dimensions_;
+    }
+
+    /**
+     *  @brief  Casts the query into the ::buffer, unless it's already in `f32_t`.
+     *  @return Pointer to the full-precision query.
+     */
+    template <typename scalar_at> f32_t const* rerank_query_(scalar_at const* vector, f32_t* buffer) const {
+        if (f32_from_(vector)(reinterpret_cast<byte_t const*>(vector), dimensions_, (byte_t*)buffer))
+            return buffer;
+        return reinterpret_cast<f32_t const*>(vector);
+    }
+
+    void rerank_matches_(search_result_t& result, f32_t const* query, std::size_t wanted) const {
+        std::size_t const bytes = dimensions_ * sizeof(f32_t);
+        punned_vector_view_t query_view{(byte_t const*)query, bytes};
+        auto metric = [&](member_cref_t const& member) {
+            punned_vector_view_t original{(byte_t const*)rerank_vector_(member.id), bytes};
+            return rerank_metric_(query_view, original);
+        };
+        result.rerank(metric, wanted);
+    }
+
+    /**
+     *  @brief  Grows the scratch buffers, that are addressed by `config.thread`,
+     *          to fit all the ::threads reserved in the index.
+     */
+    void reserve_threads_(std::size_t threads) {
+        if (cast_buffer_.size() < threads * casted_vector_bytes_)
+            cast_buffer_.resize(threads * casted_vector_bytes_);
+        if (rerank_ && rerank_buffer_.size() < threads * dimensions_)
+            rerank_buffer_.resize(threads * dimensions_);
+        std::size_t pq_scalars = pq_ ? pq_->table_bytes() / sizeof(f32_t) + dimensions_ : 0;
+        if (pq_buffer_.size() < threads * pq_scalars)
+            pq_buffer_.resize(threads * pq_scalars);
+    }
+
+    bool init_rerank_() {
+        metric_t metric = make_metric_(root_metric_.kind(), dimensions_, scalar_kind_t::f32_k);
+        if (metric.scalar_kind() != scalar_kind_t::f32_k)
+            return false;
+        rerank_ = true;
+        rerank_metric_ = metric;
+        rerank_buffer_.resize(std::thread::hardware_concurrency() * dimensions_);
+        reserve_threads_(limits().threads());
+        return true;
+    }
+
+    /**
+     *  @brief  Precedes the full-precision vectors appended to the serialized index.
+     *          Is followed by padding, aligning the vectors in memory-mapped files.
+     */
+    struct rerank_head_t {
+        char magic[8];
+        std::uint64_t dimensions;
+        std::uint64_t count;
+    };
+
+    static char const* rerank_magic_() noexcept { return "rerank"; }
+    static std::size_t rerank_padding_(std::size_t head_offset) noexcept {
+        std::size_t vectors_offset = head_offset + sizeof(rerank_head_t);
+        return divide_round_up<64>(vectors_offset) * 64 - vectors_offset;
+    }
+
+    serialization_result_t save_rerank_(char const* path) const {
+        serialization_result_t result;
+        std::FILE* file = std::fopen(path, "ab");
+        if (!file)
+            return result.failed(std::strerror(errno));
+
+        std::fseek(file, 0, SEEK_END);
+        std::size_t head_offset = static_cast<std::size_t>(std::ftell(file));
+        rerank_head_t head{};
+        std::strncpy(head.magic, rerank_magic_(), sizeof(head.magic));
+        head.dimensions = dimensions_;
+        head.count = typed_->size();
+
+        byte_t padding[64]{};
+        std::size_t padding_bytes = rerank_padding_(head_offset);
+        std::size_t vectors_bytes = head.count * dimensions_ * sizeof(f32_t);
+        bool written = std::fwrite(&head, sizeof(head), 1, file) &&
+                       (!padding_bytes || std::fwrite(padding, padding_bytes, 1, file)) &&
+                       (!vectors_bytes || std::fwrite(rerank_vector_(0), vectors_bytes, 1, file));
+        std::fclose(file);
+        if (!written)
+            return result.failed(std::strerror(errno));
+        return result;
+    }
+
+    serialization_result_t load_rerank_(char const* path) {
+        serialization_result_t result;
+        rerank_viewed_ = nullptr;
+        file_head_result_t index_head = index_metadata(path);
+        if (!index_head)
+            return result.failed(std::move(index_head.error));
+
+        std::FILE* file = std::fopen(path, "rb");
+        if (!file)
+            return result.failed(std::strerror(errno));
+
+        // Files without the full-precision vectors are traversed and ranked with compact ones
+        std::size_t head_offset = serialized_bytes_(index_head) + pq_block_bytes_();
+        rerank_head_t head{};
+        bool found = std::fseek(file, static_cast<long>(head_offset), SEEK_SET) == 0 &&
+                     std::fread(&head, sizeof(head), 1, file) &&
+                     std::strncmp(head.magic, rerank_magic_(), sizeof(head.magic)) == 0;
+        if (!found) {
+            std::fclose(file);
+            rerank_ = false;
+            return result;
+        }
+        if (head.dimensions != dimensions_ || head.count != typed_->size() || !init_rerank_()) {
+            std::fclose(file);
+            return result.failed("Incompatible full-precision vectors!");
+        }
+
+        std::size_t vectors_bytes = head.count * dimensions_ * sizeof(f32_t);
+        rerank_vectors_.resize(head.count * dimensions_);
+        bool read = std::fseek(file, static_cast<long>(rerank_padding_(head_offset)), SEEK_CUR) == 0 &&
+                    (!vectors_bytes || std::fread(rerank_vectors_.data(), vectors_bytes, 1, file));
+        std::fclose(file);
+        if (!read)
+            return result.failed("Truncated full-precision vectors!");
+        return result;
+    }
+
+    serialization_result_t view_rerank_() {
+        serialization_result_t result;
+        rerank_viewed_ = nullptr;
+        span_gt<byte_t const> tail = typed_->viewed_tail();
+        if (tail.size() >= pq_block_bytes_())
+            tail = {tail.data() + pq_block_bytes_(), tail.size() - pq_block_bytes_()};
+        rerank_head_t head{};
+        if (tail.size() >= sizeof(head))
+            std::memcpy(&head, tail.data(), sizeof(head));
+        if (std::strncmp(head.magic, rerank_magic_(), sizeof(head.magic)) != 0) {
+            rerank_ = false;
+            return result;
+        }
+        if (head.dimensions != dimensions_ || head.count != typed_->size() || !init_rerank_())
+            return result.failed("Incompatible full-precision vectors!");
+
+        // Mappings are page-aligned, so addresses share the alignment of file offsets
+        std::size_t padding_bytes = rerank_padding_(reinterpret_cast<std::uintptr_t>(tail.data()));
+        std::size_t vectors_bytes = head.count * dimensions_ * sizeof(f32_t);
+        if (tail.size() < sizeof(head) + padding_bytes + vectors_bytes)
+            return result.failed("Truncated full-precision vectors!");
+
+        rerank_vectors_.clear();
+        rerank_viewed_ = reinterpret_cast<f32_t const*>(tail.data() + sizeof(head) + padding_bytes);
+        return result;
+    }
+
+    /// @brief  Number of bytes in a file, occupied by the `index_gt` itself.
+    static std::size_t serialized_bytes_(file_head_result_t const& head) noexcept {
+        return sizeof(file_header_t) + head.bytes_for_graphs + head.bytes_for_vectors;
+    }
+
+    void init_pq_(std::shared_ptr<pq_codebook_t const> codebook) {
+        std::size_t hardware_threads = std::thread::hardware_concurrency();
+        pq_ = std::move(codebook);
+        casted_vector_bytes_ = pq_->code_bytes();
+        cast_buffer_.resize(hardware_threads * casted_vector_bytes_);
+        pq_buffer_.resize(hardware_threads * (pq_->table_bytes() / sizeof(f32_t) + dimensions_));
+        reserve_threads_(limits().threads());
+        root_metric_ = pq_metric_t{pq_};
+        typed_->change_metric(root_metric_);
+    }
+
+    /// @brief  Converts the ::vector to `f32_t` in the thread-local buffer, preparing it for the codebook.
+    template <typename scalar_at> f32_t* pq_prepare_(scalar_at const* vector, std::size_t thread) const {
+        std::size_t table_scalars = pq_->table_bytes() / sizeof(f32_t);
+        f32_t* prepared = pq_buffer_.data() + thread * (table_scalars + dimensions_) + table_scalars;
+        if (!f32_from_(vector)(reinterpret_cast<byte_t const*>(vector), dimensions_, (byte_t*)prepared))
+            std::memcpy(prepared, vector, dimensions_ * sizeof(f32_t));
+        pq_->prepare(prepared);
+        return prepared;
+    }
+
+    template <typename scalar_at> bool pq_encode_(scalar_at const* vector, byte_t* codes, std::size_t thread) const {
+        pq_->encode(pq_prepare_(vector, thread), codes);
+        return true;
+    }
+
+    /// @brief  Replaces the query with its table of distances to all the centroids.
+    template <typename scalar_at> byte_t const* pq_table_(scalar_at const* vector, std::size_t thread) const {
+        f32_t const* prepared = pq_prepare_(vector, thread);
+        f32_t* table = pq_buffer_.data() + thread * (pq_->table_bytes() / sizeof(f32_t) + dimensions_);
+        pq_->table(prepared, table);
+        return reinterpret_cast<byte_t const*>(table);
+    }
+
+    /**
+     *  @brief  Precedes the PQ centroids appended to the serialized index.
+     *          The metric kind is taken from the header of the index.
+     */
+    struct pq_head_t {
+        char magic[8];
+        std::uint64_t dimensions;
+        std::uint64_t subspaces;
+        std::uint64_t bits;
+    };
+
+    static char const* pq_magic_() noexcept { return "pq"; }
+    std::size_t pq_block_bytes_() const noexcept { return pq_ ? sizeof(pq_head_t) + pq_->data_bytes() : 0; }
+
+    serialization_result_t save_pq_(char const* path) const {
+        serialization_result_t result;
+        std::FILE* file = std::fopen(path, "ab");
+        if (!file)
+            return result.failed(std::strerror(errno));
+
+        pq_head_t head{};
+        std::strncpy(head.magic, pq_magic_(), sizeof(head.magic));
+        head.dimensions = pq_->dimensions();
+        head.subspaces = pq_->subspaces();
+        head.bits = pq_->bits();
+        bool written = std::fwrite(&head, sizeof(head), 1, file) &&
+                       std::fwrite(pq_->data(), pq_->data_bytes(), 1, file);
+        std::fclose(file);
+        if (!written)
+            return result.failed(std::strerror(errno));
+        return result;
+    }
+
+    /**
+     *  @brief  Reads the codebook following the serialized index, if present, and switches
+     *          the metric before the index itself is loaded or viewed.
+     */
+    serialization_result_t load_pq_(char const* path) {
+        serialization_result_t result;
+        file_head_result_t index_head = index_metadata(path);
+        if (!index_head)
+            return result.failed(std::move(index_head.error));
+
+        std::FILE* file = std::fopen(path, "rb");
+        if (!file)
+            return result.failed(std::strerror(errno));
+
+        pq_head_t head{};
+        bool found = std::fseek(file, static_cast<long>(serialized_bytes_(index_head)), SEEK_SET) == 0 &&
+                     std::fread(&head, sizeof(head), 1, file) &&
+                     std::strncmp(head.magic, pq_magic_(), sizeof(head.magic)) == 0;
+        if (!found) {
+            std::fclose(file);
+            if (pq_)
+                return result.failed("The file doesn't contain PQ codes!");
+            return result;
+        }
+        if (head.dimensions != dimensions_ || (head.bits != 8 && head.bits != 4) || !head.subspaces ||
+            dimensions_ % head.subspaces) {
+            std::fclose(file);
+            return result.failed("Incompatible PQ codebook!");
+        }
+
+        std::shared_ptr<pq_codebook_t> codebook =
+            std::make_shared<pq_codebook_t>(index_head.metric, dimensions_, head.subspaces, head.bits);
+        bool read = std::fread(codebook->data(), codebook->data_bytes(), 1, file);
+        std::fclose(file);
+        if (!read)
+            return result.failed("Truncated PQ codebook!");
+        init_pq_(std::move(codebook));
+        return result;
+    }
+
     static index_punned_dense_gt make_(                                                 //
         std::size_t dimensions, scalar_kind_t scalar_kind,                              //
         index_config_t config, std::size_t expansion_add, std::size_t expansion_search, //
@@ -827,6 +2111,7 @@ class index_punned_dense_gt {
         result.casted_vector_bytes_ = bytes_per_scalar(scalar_kind) * result.scalar_words_;
         result.cast_buffer_.resize(hardware_threads * result.casted_vector_bytes_);
         result.casts_ = casts;
+        result.f32_casts_ = make_casts_<f32_t>();
         result.root_metric_ = metric;
         result.free_label_ = free_label;
 
@@ -834,9 +2119,13 @@ class index_punned_dense_gt {
         result.available_threads_.resize(hardware_threads);
         std::iota(result.available_threads_.begin(), result.available_threads_.end(), 0ul);
 
+        // The typed index stores the casted vectors, so its slots are measured in bytes
+        if (config.contiguous_dimensions)
+            config.contiguous_dimensions = result.casted_vector_bytes_;
+
         // Available since C11, but only C++17, so we use the C version.
         index_t* raw = index_allocator_t{}.allocate(1);
-        new (raw) index_t(config, metric);
+        new (raw) index_t(config, metric, {}, memory_mapping_allocator_t(config.pages));
         result.typed_ = raw;
         return result;
     }
@@ -930,9 +2219,9 @@ class index_punned_dense_gt {
             return ip_metric_f32_(dimensions);
         case scalar_kind_t::f16_k:
             // Dot-product accumulates error, Cosine-distance normalizes it
-            return cos_metric_f16_(dimensions);
+            return cos_metric_f16_(dimensions).with_f32_queries(cos_f32_gt<f16_t>{dimensions});
 
-        case scalar_kind_t::f8_k: return cos_metric_f8_(dimensions);
+        case scalar_kind_t::f8_k: return cos_metric_f8_(dimensions).with_f32_queries(cos_f32_gt<f8_bits_t>{dimensions});
         case scalar_kind_t::f64_k: return ip_gt<f64_t>{};
         default: return {};
         }
@@ -940,8 +2229,10 @@ class index_punned_dense_gt {
 
     static metric_t l2sq_metric_(std::size_t dimensions, scalar_kind_t accuracy) {
         switch (accuracy) {
-        case scalar_kind_t::f8_k: return l2sq_f8_t{dimensions};
-        case scalar_kind_t::f16_k: return l2sq_gt<f16_t, f32_t>{};
+        case scalar_kind_t::f8_k:
+            return metric_t(l2sq_f8_t{dimensions}).with_f32_queries(l2sq_f32_gt<f8_bits_t>{dimensions});
+        case scalar_kind_t::f16_k:
+            return metric_t(l2sq_gt<f16_t, f32_t>{}).with_f32_queries(l2sq_f32_gt<f16_t>{dimensions});
         case scalar_kind_t::f32_k: return l2sq_gt<f32_t>{};
         case scalar_kind_t::f64_k: return l2sq_gt<f64_t>{};
         default: return {};
@@ -950,8 +2241,8 @@ class index_punned_dense_gt {
 
     static metric_t cos_metric_(std::size_t dimensions, scalar_kind_t accuracy) {
         switch (accuracy) {
-        case scalar_kind_t::f8_k: return cos_metric_f8_(dimensions);
-        case scalar_kind_t::f16_k: return cos_metric_f16_(dimensions);
+        case scalar_kind_t::f8_k: return cos_metric_f8_(dimensions).with_f32_queries(cos_f32_gt<f8_bits_t>{dimensions});
+        case scalar_kind_t::f16_k: return cos_metric_f16_(dimensions).with_f32_queries(cos_f32_gt<f16_t>{dimensions});
         case scalar_kind_t::f32_k: return cos_gt<f32_t>{};
         case scalar_kind_t::f64_k: return cos_gt<f64_t>{};
         default: return {};
@@ -13,6 +13,8 @@
 #endif
 
 #if defined(USEARCH_DEFINED_LINUX)
+#include <pthread.h>  // `pthread_setaffinity_np`
+#include <sched.h>    // `sched_getaffinity`
 #include <sys/auxv.h> // `getauxval()`
 #endif
 
@@ -320,13 +322,44 @@ struct uuid_t {
  */
 class executor_stl_t {
     std::size_t threads_count_{};
+    bool pin_threads_{};
+
+    /**
+     *  @brief  Pins the calling thread to the ::thread_idx-th of the CPUs, it is allowed to run on.
+     *          So the same thread index, and the same index context, always run on the same CPU
+     *          across the calls. The contexts themselves are allocated and first touched by the
+     *          thread, that reserves the index, so those aren't placed any closer to the workers.
+     *          Linux-only, ignored elsewhere.
+     */
+    static void pin_current_thread_(std::size_t thread_idx) noexcept {
+#if defined(USEARCH_DEFINED_LINUX)
+        cpu_set_t allowed;
+        CPU_ZERO(&allowed);
+        if (sched_getaffinity(0, sizeof(allowed), &allowed) != 0)
+            return;
+        std::size_t remaining = thread_idx % static_cast<std::size_t>(CPU_COUNT(&allowed));
+        for (int cpu = 0; cpu != CPU_SETSIZE; ++cpu) {
+            if (!CPU_ISSET(cpu, &allowed) || remaining--)
+                continue;
+            cpu_set_t chosen;
+            CPU_ZERO(&chosen);
+            CPU_SET(cpu, &chosen);
+            pthread_setaffinity_np(pthread_self(), sizeof(chosen), &chosen);
+            return;
+        }
+#else
+        (void)thread_idx;
+#endif
+    }
 
   public:
     /**
      *  @param threads_count The number of threads to be used for parallel execution.
+     *  @param pin_threads Pins every thread to its own CPU, so they don't migrate between the cores.
      */
-    executor_stl_t(std::size_t threads_count = 0) noexcept
-        : threads_count_(threads_count ? threads_count : std::thread::hardware_concurrency()) {}
+    executor_stl_t(std::size_t threads_count = 0, bool pin_threads = false) noexcept
+        : threads_count_(threads_count ? threads_count : std::thread::hardware_concurrency()),
+          pin_threads_(pin_threads) {}
 
     /**
      *  @return Maximum number of threads available to the executor.
@@ -345,6 +378,8 @@ class executor_stl_t {
         std::size_t tasks_per_thread = (tasks / threads_count_) + ((tasks % threads_count_) != 0);
         for (std::size_t thread_idx = 0; thread_idx != threads_count_; ++thread_idx) {
             threads_pool.emplace_back([=]() {
+                if (pin_threads_)
+                    pin_current_thread_(thread_idx);
                 for (std::size_t task_idx = thread_idx * tasks_per_thread;
                      task_idx < (std::min)(tasks, thread_idx * tasks_per_thread + tasks_per_thread); ++task_idx)
                     thread_aware_function(thread_idx, task_idx);
@@ -363,7 +398,11 @@ class executor_stl_t {
     void execute_bulk(thread_aware_function_at&& thread_aware_function) noexcept(false) {
         std::vector<std::thread> threads_pool;
         for (std::size_t thread_idx = 0; thread_idx != threads_count_; ++thread_idx)
-            threads_pool.emplace_back([=]() { thread_aware_function(thread_idx); });
+            threads_pool.emplace_back([=]() {
+                if (pin_threads_)
+                    pin_current_thread_(thread_idx);
+                thread_aware_function(thread_idx);
+            });
         for (std::size_t thread_idx = 0; thread_idx != threads_count_; ++thread_idx)
             threads_pool[thread_idx].join();
     }
@@ -387,7 +426,7 @@ class executor_openmp_t {
     /**
      *  @return Maximum number of threads available to the executor.
      */
-    std::size_t size() const noexcept { return omp_get_num_threads(); }
+    std::size_t size() const noexcept { return omp_get_max_threads(); }
 
     /**
      *  @brief Executes tasks in bulk using the specified thread-aware function.
@@ -464,7 +503,9 @@ using aligned_allocator_t = aligned_allocator_gt<>;
 
 /**
  *  @brief  Memory-mapping allocator designed for "alloc many, free at once" usage patterns.
- *          Thread-safe, @b except constructors and destructors.
+ *          Thread-safe, @b except constructors and destructors. Individually freed blocks are
+ *          kept in free lists by size, which for the nodes of a dense index means by level,
+ *          and are reused by the next allocations of the same size.
  *
  *  Using this memory allocator won't affect your overall speed much, as that is not the bottleneck.
  *  However, it can drastically improve memory usage especcially for huge indexes of small vectors.
@@ -473,6 +514,9 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
 
     static constexpr std::size_t min_capacity() { return 1024 * 1024 * 4; }
     static constexpr std::size_t capacity_multiplier() { return 2; }
+    static constexpr std::size_t lane_capacity() { return 1024 * 64; }
+    static constexpr std::size_t max_lanes() { return 128; }
+    static constexpr std::size_t max_size_classes() { return 32; }
     static constexpr std::size_t head_size() {
         /// Pointer to the the previous arena and the size of the current one.
         return divide_round_up<alignment_ak>(sizeof(byte_t*) + sizeof(std::size_t)) * alignment_ak;
@@ -483,6 +527,42 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
     std::size_t last_usage_ = head_size();
     std::size_t last_capacity_ = min_capacity();
     std::size_t wasted_space_ = 0;
+    memory_pages_config_t pages_config_{};
+    /// @brief The smallest pages among all arenas, and if all of them are pinned.
+    memory_pages_stats_t pages_stats_{};
+
+    /// @brief Per-thread bump region, refilled from the shared arenas, so that most allocations skip the mutex.
+    struct usearch_align_m lane_t {
+        byte_t* begin = nullptr;
+        std::size_t usage = 0;
+        std::size_t capacity = 0;
+        std::size_t wasted = 0;
+    };
+    lane_t lanes_[max_lanes()];
+
+    /// @brief Singly-linked list of freed blocks of the same size, linked through their first bytes.
+    struct size_class_t {
+        std::size_t bytes = 0;
+        byte_t* head = nullptr;
+    };
+    size_class_t size_classes_[max_size_classes()];
+    std::size_t free_bytes_ = 0;
+    /// @brief Number of blocks in all free lists, checked by lanes before taking the lock.
+    std::atomic<std::size_t> free_blocks_{0};
+
+    /// @brief Pops a freed block of exactly ::extended_bytes. Must be called under the `mutex_`.
+    byte_t* pop_free_(std::size_t extended_bytes) noexcept {
+        for (size_class_t& size_class : size_classes_) {
+            if (size_class.bytes != extended_bytes || !size_class.head)
+                continue;
+            byte_t* block = size_class.head;
+            std::memcpy(&size_class.head, block, sizeof(byte_t*));
+            free_bytes_ -= extended_bytes;
+            free_blocks_ -= 1;
+            return block;
+        }
+        return nullptr;
+    }
 
   public:
     using value_type = byte_t;
@@ -491,15 +571,27 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
     using const_pointer = byte_t const*;
 
     memory_mapping_allocator_gt() = default;
+    explicit memory_mapping_allocator_gt(memory_pages_config_t pages_config) noexcept : pages_config_(pages_config) {}
     memory_mapping_allocator_gt(memory_mapping_allocator_gt&& other) noexcept
         : last_arena_(exchange(other.last_arena_, nullptr)), last_usage_(exchange(other.last_usage_, 0)),
-          last_capacity_(exchange(other.last_capacity_, 0)), wasted_space_(exchange(other.wasted_space_, 0)) {}
+          last_capacity_(exchange(other.last_capacity_, 0)), wasted_space_(exchange(other.wasted_space_, 0)),
+          pages_config_(other.pages_config_), pages_stats_(exchange(other.pages_stats_, {})),
+          free_bytes_(exchange(other.free_bytes_, 0)), free_blocks_(other.free_blocks_.exchange(0)) {
+        std::swap(lanes_, other.lanes_);
+        std::swap(size_classes_, other.size_classes_);
+    }
 
     memory_mapping_allocator_gt& operator=(memory_mapping_allocator_gt&& other) noexcept {
         std::swap(last_arena_, other.last_arena_);
         std::swap(last_usage_, other.last_usage_);
         std::swap(last_capacity_, other.last_capacity_);
         std::swap(wasted_space_, other.wasted_space_);
+        std::swap(pages_config_, other.pages_config_);
+        std::swap(pages_stats_, other.pages_stats_);
+        std::swap(lanes_, other.lanes_);
+        std::swap(size_classes_, other.size_classes_);
+        std::swap(free_bytes_, other.free_bytes_);
+        free_blocks_ = other.free_blocks_.exchange(free_blocks_.load());
         return *this;
     }
 
@@ -528,21 +620,28 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
         last_usage_ = head_size();
         last_capacity_ = min_capacity();
         wasted_space_ = 0;
+        pages_stats_ = {};
+        std::fill(lanes_, lanes_ + max_lanes(), lane_t{});
+        std::fill(size_classes_, size_classes_ + max_size_classes(), size_class_t{});
+        free_bytes_ = 0;
+        free_blocks_ = 0;
     }
 
     /**
      *  @brief Copy constructor.
-     *  @note This is a no-op copy constructor since the allocator is not copyable.
+     *  @note Only copies the pages configuration, since the arenas are not copyable.
      */
-    memory_mapping_allocator_gt(memory_mapping_allocator_gt const&) noexcept {}
+    memory_mapping_allocator_gt(memory_mapping_allocator_gt const& other) noexcept
+        : pages_config_(other.pages_config_) {}
 
     /**
      *  @brief Copy assignment operator.
-     *  @note This is a no-op copy assignment operator since the allocator is not copyable.
+     *  @note Only copies the pages configuration, discarding the own arenas, since those are not copyable.
      *  @return Reference to the allocator after the assignment.
      */
-    memory_mapping_allocator_gt& operator=(memory_mapping_allocator_gt const&) noexcept {
+    memory_mapping_allocator_gt& operator=(memory_mapping_allocator_gt const& other) noexcept {
         reset();
+        pages_config_ = other.pages_config_;
         return *this;
     }
 
@@ -558,21 +657,21 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
             return nullptr;
 
         std::unique_lock<std::mutex> lock(mutex_);
+        if (byte_t* block = free_blocks_ ? pop_free_(extended_bytes) : nullptr)
+            return block;
         if (!last_arena_ || (last_usage_ + extended_bytes > last_capacity_)) {
             std::size_t new_cap = last_capacity_ * capacity_multiplier();
-#if defined(USEARCH_DEFINED_WINDOWS)
-            byte_t* new_arena = (byte_t*)(::VirtualAlloc(NULL, new_cap, MEM_COMMIT | MEM_RESERVE, PAGE_READWRITE));
-            if (new_arena == nullptr)
-                return nullptr;
-#else
-            byte_t* new_arena = (byte_t*)mmap(NULL, new_cap, PROT_WRITE | PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS, 0, 0);
+            memory_pages_stats_t new_pages;
+            byte_t* new_arena = map_memory_pages(new_cap, pages_config_, new_pages);
             if (!new_arena)
                 return nullptr;
-#endif
             std::memcpy(new_arena, &last_arena_, sizeof(byte_t*));
             std::memcpy(new_arena + sizeof(byte_t*), &new_cap, sizeof(std::size_t));
 
-            wasted_space_ += total_reserved();
+            wasted_space_ += last_capacity_ - last_usage_;
+            pages_stats_.locked = new_pages.locked && (pages_stats_.locked || !last_arena_);
+            pages_stats_.page_bytes = last_arena_ ? (std::min)(pages_stats_.page_bytes, new_pages.page_bytes)
+                                                  : new_pages.page_bytes;
             last_arena_ = new_arena;
             last_capacity_ = new_cap;
             last_usage_ = head_size();
@@ -582,6 +681,39 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
         return last_arena_ + exchange(last_usage_, last_usage_ + extended_bytes);
     }
 
+    /**
+     *  @brief Allocates an @b uninitialized block of memory from the lane of the given thread.
+     *         Doesn't lock, unless the lane has to be refilled from the shared arenas.
+     *  @param count_bytes The number of bytes to allocate.
+     *  @param thread The index of the calling thread. Every index may only be used by one thread at a time.
+     *  @return A pointer to the allocated memory block, or `nullptr` if allocation fails.
+     */
+    inline byte_t* allocate(std::size_t count_bytes, std::size_t thread) noexcept {
+        std::size_t extended_bytes = divide_round_up<alignment_ak>(count_bytes) * alignment_ak;
+        if (thread >= max_lanes() || extended_bytes > lane_capacity())
+            return allocate(count_bytes);
+
+        if (free_blocks_.load(std::memory_order_relaxed)) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            if (byte_t* block = pop_free_(extended_bytes))
+                return block;
+        }
+
+        lane_t& lane = lanes_[thread];
+        if (lane.usage + extended_bytes > lane.capacity) {
+            byte_t* new_lane = allocate(lane_capacity());
+            if (!new_lane)
+                return nullptr;
+            lane.wasted += lane.capacity - lane.usage;
+            lane.begin = new_lane;
+            lane.usage = 0;
+            lane.capacity = lane_capacity();
+        }
+
+        lane.wasted += extended_bytes - count_bytes;
+        return lane.begin + exchange(lane.usage, lane.usage + extended_bytes);
+    }
+
     /**
      *  @brief Returns the amount of memory used by the allocator across all arenas.
      *  @return The amount of space in bytes.
@@ -602,18 +734,59 @@ template <std::size_t alignment_ak = 1> class memory_mapping_allocator_gt {
      *  @brief Returns the amount of wasted space due to alignment.
      *  @return The amount of wasted space in bytes.
      */
-    std::size_t total_wasted() const noexcept { return wasted_space_; }
+    std::size_t total_wasted() const noexcept {
+        std::size_t total = wasted_space_;
+        for (lane_t const& lane : lanes_)
+            total += lane.wasted;
+        return total;
+    }
 
     /**
      *  @brief Returns the amount of remaining memory already reserved but not yet used.
      *  @return The amount of reserved memory in bytes.
      */
-    std::size_t total_reserved() const noexcept { return last_capacity_ - last_usage_; }
+    std::size_t total_reserved() const noexcept {
+        std::size_t total = last_capacity_ - last_usage_ + free_bytes_;
+        for (lane_t const& lane : lanes_)
+            total += lane.capacity - lane.usage;
+        return total;
+    }
+
+    /**
+     *  @brief Reports the smallest pages, that back the arenas, and if all of them are pinned in RAM.
+     *  @return Zero page size, if no arenas were mapped yet.
+     */
+    memory_pages_stats_t pages() const noexcept { return pages_stats_; }
 
     /**
-     *  @warning The very first memory de-allocation discards all the arenas!
+     *  @brief Returns a block into the free list of its size, to be reused by the next allocations.
+     *  @warning Calling it with a `nullptr` discards all the arenas at once!
      */
-    void deallocate(byte_t* = nullptr, std::size_t = 0) noexcept { reset(); }
+    void deallocate(byte_t* begin = nullptr, std::size_t count_bytes = 0) noexcept {
+        if (!begin)
+            return reset();
+
+        std::size_t extended_bytes = divide_round_up<alignment_ak>(count_bytes) * alignment_ak;
+        std::unique_lock<std::mutex> lock(mutex_);
+        size_class_t* matching_class = nullptr;
+        for (size_class_t& size_class : size_classes_) {
+            if (size_class.bytes == extended_bytes || (!size_class.bytes && !matching_class))
+                matching_class = &size_class;
+            if (size_class.bytes == extended_bytes)
+                break;
+        }
+
+        // Blocks too small to be linked, or of too many distinct sizes, are just left behind
+        if (extended_bytes < sizeof(byte_t*) || !matching_class) {
+            wasted_space_ += extended_bytes;
+            return;
+        }
+        matching_class->bytes = extended_bytes;
+        std::memcpy(begin, &matching_class->head, sizeof(byte_t*));
+        matching_class->head = begin;
+        free_bytes_ += extended_bytes;
+        free_blocks_ += 1;
+    }
 };
 
 using memory_mapping_allocator_t = memory_mapping_allocator_gt<>;
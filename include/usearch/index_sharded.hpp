@@ -0,0 +1,367 @@
+#pragma once
+#include <string> // `std::to_string`
+#include <vector> // `std::vector`
+
+#include <usearch/index_punned_dense.hpp>
+
+namespace unum {
+namespace usearch {
+
+/**
+ *  @brief  Partitions the entries between several independent ::index_punned_dense_gt shards.
+ *          Every label is routed to a shard by its hash, so the insertions into different shards
+ *          never contend for the same locks, allocators or lookup tables. The searches fan out to
+ *          all the shards and the per-shard top-k lists are merged into one.
+ *
+ *  Every shard is a complete index with its own graph, so the recall of the merged results
+ *  is usually slightly higher than of a single index, at the cost of more distance evaluations.
+ *
+ *  @tparam label_at The type of unique labels to assign to vectors.
+ *  @tparam id_at The type of unique identifiers within every shard.
+ */
+template <typename label_at = std::int64_t, typename id_at = std::uint32_t> //
+class index_sharded_gt {
+  public:
+    using shard_t = index_punned_dense_gt<label_at, id_at>;
+    using label_t = label_at;
+    using id_t = id_at;
+    using distance_t = punned_distance_t;
+
+    using add_result_t = typename shard_t::add_result_t;
+    using add_many_result_t = typename shard_t::add_many_result_t;
+    using labeling_result_t = typename shard_t::labeling_result_t;
+    using serialization_result_t = typename shard_t::serialization_result_t;
+    using stats_t = typename shard_t::stats_t;
+
+  private:
+    std::vector<shard_t> shards_;
+
+  public:
+    index_sharded_gt() = default;
+    index_sharded_gt(index_sharded_gt&&) = default;
+    index_sharded_gt& operator=(index_sharded_gt&&) = default;
+
+    /**
+     *  @brief Constructs an instance of ::index_sharded_gt with identically configured shards.
+     *  @param[in] shards The number of shards to split the entries between.
+     *  @param[in] dimensions The of dimensions per vector.
+     *  @param[in] metric One of the default supported metric @b kinds for distance measurements.
+     *  @param[in] config The configuration of every shard (optional).
+     *  @param[in] accuracy The scalar kind used for internal representations (optional).
+     *  @param[in] expansion_add The expansion factor for adding vectors (optional).
+     *  @param[in] expansion_search The expansion factor for searching vectors (optional).
+     *  @return An instance of ::index_sharded_gt. Without ::shards, it has none and rejects insertions and searches.
+     */
+    static index_sharded_gt make(                                  //
+        std::size_t shards, std::size_t dimensions,                //
+        metric_kind_t metric,                                      //
+        index_config_t config = {},                                //
+        scalar_kind_t accuracy = scalar_kind_t::f32_k,             //
+        std::size_t expansion_add = default_expansion_add(),       //
+        std::size_t expansion_search = default_expansion_search()) {
+
+        index_sharded_gt result;
+        if (!shards)
+            return result;
+        result.shards_.reserve(shards);
+        for (std::size_t i = 0; i != shards; ++i)
+            result.shards_.push_back(
+                shard_t::make(dimensions, metric, config, accuracy, expansion_add, expansion_search));
+        return result;
+    }
+
+    std::size_t shards_count() const noexcept { return shards_.size(); }
+    shard_t& shard(std::size_t i) noexcept { return shards_[i]; }
+    shard_t const& shard(std::size_t i) const noexcept { return shards_[i]; }
+
+    std::size_t dimensions() const { return shards_.empty() ? 0 : shards_.front().dimensions(); }
+    std::size_t size() const { return sum_([](shard_t const& shard) { return shard.size(); }); }
+    std::size_t capacity() const { return sum_([](shard_t const& shard) { return shard.capacity(); }); }
+    std::size_t memory_usage() const { return sum_([](shard_t const& shard) { return shard.memory_usage(); }); }
+
+    stats_t stats() const {
+        stats_t result{};
+        for (shard_t const& shard : shards_) {
+            stats_t shard_stats = shard.stats();
+            result.nodes += shard_stats.nodes;
+            result.edges += shard_stats.edges;
+            result.max_edges += shard_stats.max_edges;
+            result.allocated_bytes += shard_stats.allocated_bytes;
+            result.lock_acquisitions += shard_stats.lock_acquisitions;
+            result.lock_spins += shard_stats.lock_spins;
+        }
+        return result;
+    }
+
+    /**
+     *  @brief  Splits the capacity evenly between the shards. Every shard gets all the ::limits threads,
+     *          as concurrent insertions of different labels may still land into the same shard.
+     */
+    bool reserve(index_limits_t limits) {
+        if (shards_.empty())
+            return false;
+        index_limits_t shard_limits = limits;
+        shard_limits.members = divide_round_up(limits.members, shards_.size());
+        for (shard_t& shard : shards_)
+            if (!shard.reserve(shard_limits))
+                return false;
+        return true;
+    }
+
+    void clear() {
+        for (shard_t& shard : shards_)
+            shard.clear();
+    }
+
+    /**
+     *  @brief  Inserts a vector into the shard of its label. If that one is full, as the hashes are
+     *          never perfectly balanced, the next shard with free capacity is used instead. Thread-safe.
+     */
+    template <typename scalar_at> add_result_t add(label_t label, scalar_at const* vector) {
+        if (shards_.empty())
+            return add_result_t{}.failed("The index has no shards!");
+        return shards_[shard_for_insert_(label)].add(label, vector);
+    }
+
+    /**
+     *  @brief  Inserts many vectors at once, filling all the shards in parallel, one thread per shard.
+     *          The vectors are gathered per shard, to be inserted with `add_many` of every shard.
+     *          If one of the shards fails, the others keep the entries they have already inserted,
+     *          so the error isn't rolled back and the labels of the batch should be checked with `contains`.
+     *  @param stride Number of bytes between the starts of consecutive vectors.
+     */
+    template <typename scalar_at, typename executor_at = dummy_executor_t>
+    add_many_result_t add_many(                                                                 //
+        label_t const* labels, scalar_at const* vectors, std::size_t count, std::size_t stride, //
+        executor_at&& executor = executor_at{}) {
+
+        // Route every entry, respecting the capacities of the shards
+        std::size_t const shards = shards_.size();
+        add_many_result_t result;
+        if (!shards)
+            return result.failed("The index has no shards!");
+        std::vector<std::size_t> free_slots(shards);
+        std::vector<std::vector<std::size_t>> routes(shards);
+        for (std::size_t shard_idx = 0; shard_idx != shards; ++shard_idx)
+            free_slots[shard_idx] = shards_[shard_idx].capacity() - shards_[shard_idx].size();
+        for (std::size_t i = 0; i != count; ++i) {
+            std::size_t shard_idx = shard_of(labels[i]);
+            for (std::size_t tries = 0; tries != shards && !free_slots[shard_idx]; ++tries)
+                shard_idx = (shard_idx + 1) % shards;
+            if (!free_slots[shard_idx])
+                return result.failed("Reserve capacity ahead of insertions!");
+            --free_slots[shard_idx];
+            routes[shard_idx].push_back(i);
+        }
+
+        std::size_t const vector_bytes = shards_.front().scalar_words() * sizeof(scalar_at);
+        std::vector<add_many_result_t> results(shards);
+        executor.execute_bulk(shards, [&](std::size_t, std::size_t shard_idx) {
+            std::vector<std::size_t> const& route = routes[shard_idx];
+            std::vector<label_t> shard_labels(route.size());
+            std::vector<byte_t> shard_vectors(route.size() * vector_bytes);
+            for (std::size_t j = 0; j != route.size(); ++j) {
+                shard_labels[j] = labels[route[j]];
+                std::memcpy(shard_vectors.data() + j * vector_bytes,
+                            reinterpret_cast<byte_t const*>(vectors) + route[j] * stride, vector_bytes);
+            }
+            results[shard_idx] = shards_[shard_idx].add_many(                                //
+                shard_labels.data(), reinterpret_cast<scalar_at const*>(shard_vectors.data()), //
+                route.size(), vector_bytes);
+        });
+
+        for (add_many_result_t& shard_result : results) {
+            if (!shard_result)
+                return result.failed(std::move(shard_result.error));
+            result.new_size += shard_result.new_size;
+            result.cycles += shard_result.cycles;
+            result.measurements += shard_result.measurements;
+            result.lock_acquisitions += shard_result.lock_acquisitions;
+            result.lock_spins += shard_result.lock_spins;
+        }
+        return result;
+    }
+
+    /**
+     *  @brief  Matches of a fanned-out search. Unlike the results of a single shard,
+     *          those own their memory, as every shard may be searched by a different thread.
+     */
+    struct search_result_t {
+        std::vector<label_t> labels;
+        std::vector<distance_t> distances;
+        std::size_t count{};
+        std::size_t cycles{};
+        std::size_t measurements{};
+        error_t error{};
+
+        explicit operator bool() const noexcept { return !error; }
+        search_result_t failed(error_t message) noexcept {
+            error = std::move(message);
+            return std::move(*this);
+        }
+
+        inline operator std::size_t() const noexcept { return count; }
+        inline std::size_t size() const noexcept { return count; }
+
+        inline std::size_t dump_to(label_t* labels_out, distance_t* distances_out) const noexcept {
+            std::copy(labels.begin(), labels.begin() + count, labels_out);
+            std::copy(distances.begin(), distances.begin() + count, distances_out);
+            return count;
+        }
+        inline std::size_t dump_to(label_t* labels_out) const noexcept {
+            std::copy(labels.begin(), labels.begin() + count, labels_out);
+            return count;
+        }
+    };
+
+    /**
+     *  @brief  Searches every shard for the ::wanted closest matches, in parallel, and merges those.
+     *          Thread-safe, as long as the number of concurrent callers doesn't exceed the reserved threads.
+     */
+    template <typename scalar_at, typename executor_at = dummy_executor_t>
+    search_result_t search(scalar_at const* vector, std::size_t wanted, executor_at&& executor = executor_at{}) const {
+
+        // Every shard writes its own slice, sorted by distance
+        std::size_t const shards = shards_.size();
+        search_result_t result;
+        if (!shards)
+            return result.failed("The index has no shards!");
+        std::vector<label_t> shard_labels(shards * wanted);
+        std::vector<distance_t> shard_distances(shards * wanted);
+        std::vector<std::size_t> shard_counts(shards), shard_cycles(shards), shard_measurements(shards);
+        std::vector<char const*> shard_errors(shards);
+        executor.execute_bulk(shards, [&](std::size_t, std::size_t shard_idx) {
+            auto shard_result = shards_[shard_idx].search(vector, wanted);
+            shard_errors[shard_idx] = shard_result.error.what();
+            shard_result.error = nullptr;
+            shard_counts[shard_idx] = shard_result.dump_to( //
+                shard_labels.data() + shard_idx * wanted, shard_distances.data() + shard_idx * wanted);
+            shard_cycles[shard_idx] = shard_result.cycles;
+            shard_measurements[shard_idx] = shard_result.measurements;
+        });
+        for (std::size_t shard_idx = 0; shard_idx != shards; ++shard_idx) {
+            if (shard_errors[shard_idx])
+                return result.failed(shard_errors[shard_idx]);
+            result.cycles += shard_cycles[shard_idx];
+            result.measurements += shard_measurements[shard_idx];
+        }
+
+        // Merge the sorted lists, repeatedly picking the closest head.
+        // There are only a few shards, so a linear scan beats a heap here.
+        result.labels.resize(wanted);
+        result.distances.resize(wanted);
+        std::vector<std::size_t> heads(shards);
+        for (; result.count != wanted; ++result.count) {
+            std::size_t best_shard = shards;
+            for (std::size_t shard_idx = 0; shard_idx != shards; ++shard_idx) {
+                if (heads[shard_idx] == shard_counts[shard_idx])
+                    continue;
+                if (best_shard == shards || shard_distances[shard_idx * wanted + heads[shard_idx]] <
+                                                shard_distances[best_shard * wanted + heads[best_shard]])
+                    best_shard = shard_idx;
+            }
+            if (best_shard == shards)
+                break;
+            std::size_t offset = best_shard * wanted + heads[best_shard]++;
+            result.labels[result.count] = shard_labels[offset];
+            result.distances[result.count] = shard_distances[offset];
+        }
+        return result;
+    }
+
+    template <typename scalar_at> bool get(label_t label, scalar_at* vector) const {
+        std::size_t shard_idx = shard_with_(label);
+        return shard_idx != shards_.size() && shards_[shard_idx].get(label, vector);
+    }
+
+    bool contains(label_t label) const { return shard_with_(label) != shards_.size(); }
+
+    labeling_result_t remove(label_t label) {
+        std::size_t shard_idx = shard_with_(label);
+        return shard_idx != shards_.size() ? shards_[shard_idx].remove(label) : labeling_result_t{};
+    }
+
+    /**
+     *  @brief  Saves every shard into a separate file, named by appending the shard number to the ::path.
+     */
+    serialization_result_t save(char const* path) const {
+        for (std::size_t i = 0; i != shards_.size(); ++i) {
+            serialization_result_t result = shards_[i].save(shard_path_(path, i).c_str());
+            if (!result)
+                return result;
+        }
+        return {};
+    }
+
+    /**
+     *  @brief  Loads the shards saved with `save`. The index must have been made with as many shards.
+     */
+    serialization_result_t load(char const* path) {
+        for (std::size_t i = 0; i != shards_.size(); ++i) {
+            serialization_result_t result = shards_[i].load(shard_path_(path, i).c_str());
+            if (!result)
+                return result;
+        }
+        return {};
+    }
+
+    /**
+     *  @brief  Memory-maps the shards saved with `save`. The index must have been made with as many shards.
+     */
+    serialization_result_t view(char const* path) {
+        for (std::size_t i = 0; i != shards_.size(); ++i) {
+            serialization_result_t result = shards_[i].view(shard_path_(path, i).c_str());
+            if (!result)
+                return result;
+        }
+        return {};
+    }
+
+    /**
+     *  @brief  Picks the preferred shard for a ::label, hashing its bytes with FNV-1a,
+     *          so that any trivially copyable labels, like `uuid_t`, can be routed.
+     *  @return The shard index or `shards_count()`, if the index has no shards.
+     */
+    std::size_t shard_of(label_t label) const noexcept {
+        byte_t bytes[sizeof(label_t)];
+        std::memcpy(bytes, &label, sizeof(label_t));
+        std::uint64_t hash = 14695981039346656037ull;
+        for (byte_t byte : bytes)
+            hash = (hash ^ byte) * 1099511628211ull;
+        return shards_.empty() ? 0 : static_cast<std::size_t>(hash % shards_.size());
+    }
+
+  private:
+    template <typename getter_at> std::size_t sum_(getter_at&& getter) const {
+        std::size_t result = 0;
+        for (shard_t const& shard : shards_)
+            result += getter(shard);
+        return result;
+    }
+
+    static std::string shard_path_(char const* path, std::size_t shard_idx) {
+        return std::string(path) + "." + std::to_string(shard_idx);
+    }
+
+    std::size_t shard_for_insert_(label_t label) const {
+        std::size_t const shards = shards_.size();
+        std::size_t shard_idx = shard_of(label);
+        for (std::size_t tries = 0; tries != shards; ++tries, shard_idx = (shard_idx + 1) % shards)
+            if (shards_[shard_idx].size() < shards_[shard_idx].capacity())
+                return shard_idx;
+        return shard_of(label);
+    }
+
+    /// @brief  Finds the shard containing the ::label, starting with the preferred one.
+    std::size_t shard_with_(label_t label) const {
+        std::size_t const shards = shards_.size();
+        std::size_t shard_idx = shard_of(label);
+        for (std::size_t tries = 0; tries != shards; ++tries, shard_idx = (shard_idx + 1) % shards)
+            if (shards_[shard_idx].contains(label))
+                return shard_idx;
+        return shards;
+    }
+};
+
+} // namespace usearch
+} // namespace unum
@@ -14,6 +14,7 @@
  */
 #include <limits> // `std::numeric_limits`
 #include <thread> // `std::thread`
+#include <vector> // `std::vector`
 
 #define _CRT_SECURE_NO_WARNINGS
 #define PY_SSIZE_T_CLEAN
@@ -46,14 +47,19 @@ using distance_t = punned_distance_t;
 using dense_index_t = punned_small_t;
 using dense_add_result_t = typename dense_index_t::add_result_t;
 using dense_search_result_t = typename dense_index_t::search_result_t;
+using dense_search_batch_result_t = typename dense_index_t::search_batch_result_t;
 using dense_labeling_result_t = typename dense_index_t::labeling_result_t;
 
 struct dense_index_py_t : public dense_index_t {
     using native_t = dense_index_t;
     using native_t::add;
+    using native_t::add_many;
     using native_t::capacity;
+    using native_t::removed_count;
     using native_t::reserve;
     using native_t::search;
+    using native_t::search_batch;
+    using native_t::search_range;
     using native_t::size;
 
     dense_index_py_t(native_t&& base) : native_t(std::move(base)) {}
@@ -207,19 +213,46 @@ static void add_typed_to_index(                                              //
     bool copy, std::size_t threads) {
 
     Py_ssize_t vectors_count = vectors_info.shape[0];
-    char const* vectors_data = reinterpret_cast<char const*>(vectors_info.ptr);
-    char const* labels_data = reinterpret_cast<char const*>(labels_info.ptr);
+    scalar_at const* vectors_data = reinterpret_cast<scalar_at const*>(vectors_info.ptr);
+    label_t const* labels_data = reinterpret_cast<label_t const*>(labels_info.ptr);
+
+    // The bulk insertion expects the labels to be contiguous
+    std::vector<label_t> labels_copy;
+    if (labels_info.strides[0] != static_cast<Py_ssize_t>(sizeof(label_t))) {
+        labels_copy.resize(vectors_count);
+        for (Py_ssize_t i = 0; i != vectors_count; ++i)
+            labels_copy[i] = *reinterpret_cast<label_t const*>( //
+                reinterpret_cast<char const*>(labels_info.ptr) + i * labels_info.strides[0]);
+        labels_data = labels_copy.data();
+    }
 
-    executor_default_t{threads}.execute_bulk(vectors_count, [&](std::size_t thread_idx, std::size_t task_idx) {
-        add_config_t config;
-        config.store_vector = copy;
-        config.thread = thread_idx;
-        label_t label = *reinterpret_cast<label_t const*>(labels_data + task_idx * labels_info.strides[0]);
-        scalar_at const* vector = reinterpret_cast<scalar_at const*>(vectors_data + task_idx * vectors_info.strides[0]);
-        index.add(label, vector, config).error.raise();
+    add_config_t config;
+    config.store_vector = copy;
+    executor_default_t executor{threads};
+    std::size_t count = static_cast<std::size_t>(vectors_count);
+    std::size_t stride = static_cast<std::size_t>(vectors_info.strides[0]);
+    auto vector_at = [&](std::size_t i) {
+        return reinterpret_cast<scalar_at const*>(reinterpret_cast<char const*>(vectors_data) + i * stride);
+    };
+
+    // The nodes of removed entries are reused one by one, as the bulk insertion only appends
+    std::size_t reused = (std::min)(index.removed_count(), count);
+    executor.execute_bulk(reused, [&](std::size_t thread_idx, std::size_t task_idx) {
+        add_config_t thread_config = config;
+        thread_config.thread = thread_idx;
+        index.add(labels_data[task_idx], vector_at(task_idx), thread_config).error.raise();
         if (PyErr_CheckSignals() != 0)
             throw py::error_already_set();
     });
+
+    // The rest is appended in chunks, so that long insertions can still be interrupted
+    constexpr std::size_t chunk_size = 4096;
+    for (std::size_t begin = reused; begin < count; begin += chunk_size) {
+        std::size_t chunk = (std::min)(chunk_size, count - begin);
+        index.add_many(labels_data + begin, vector_at(begin), chunk, stride, config, executor).error.raise();
+        if (PyErr_CheckSignals() != 0)
+            throw py::error_already_set();
+    }
 }
 
 static void add_many_to_index(                                      //
@@ -323,15 +356,24 @@ static void search_typed(                                   //
     if (!index.reserve(index_limits_t(index.size(), threads)))
         throw std::invalid_argument("Out of memory!");
 
-    executor_default_t{threads}.execute_bulk(vectors_count, [&](std::size_t thread_idx, std::size_t task_idx) {
+    // Every thread interleaves the traversals of a few queries at a time, hiding the memory latency.
+    std::size_t const batch_size = default_interleave() * 8;
+    std::size_t const batches_count = divide_round_up(static_cast<std::size_t>(vectors_count), batch_size);
+    executor_default_t{threads}.execute_bulk(batches_count, [&](std::size_t thread_idx, std::size_t batch_idx) {
         search_config_t config;
         config.thread = thread_idx;
         config.exact = exact;
-        scalar_at const* vector = (scalar_at const*)(vectors_data + task_idx * vectors_info.strides[0]);
-        dense_search_result_t result = index.search(vector, wanted, config);
+        std::size_t first_idx = batch_idx * batch_size;
+        std::size_t batch_count = (std::min)(batch_size, static_cast<std::size_t>(vectors_count) - first_idx);
+        scalar_at const* vectors = (scalar_at const*)(vectors_data + first_idx * vectors_info.strides[0]);
+        auto export_result = [&](std::size_t query_idx, dense_search_result_t const& query_result) {
+            std::size_t task_idx = first_idx + query_idx;
+            counts_py1d(task_idx) =
+                static_cast<Py_ssize_t>(query_result.dump_to(&labels_py2d(task_idx, 0), &distances_py2d(task_idx, 0)));
+        };
+        dense_search_batch_result_t result =
+            index.search_batch(vectors, batch_count, vectors_info.strides[0], wanted, export_result, config);
         result.error.raise();
-        counts_py1d(task_idx) =
-            static_cast<Py_ssize_t>(result.dump_to(&labels_py2d(task_idx, 0), &distances_py2d(task_idx, 0)));
         if (PyErr_CheckSignals() != 0)
             throw py::error_already_set();
     });
@@ -387,6 +429,142 @@ static py::tuple search_many_in_index( //
     return results;
 }
 
+static py::tuple search_range_one_in_index(dense_index_py_t& index, py::buffer vector, distance_t radius, bool exact) {
+
+    py::buffer_info vector_info = vector.request();
+    Py_ssize_t vector_dimensions = vector_info.shape[0];
+    char const* vector_data = reinterpret_cast<char const*>(vector_info.ptr);
+    if (vector_dimensions != static_cast<Py_ssize_t>(index.scalar_words()))
+        throw std::invalid_argument("The number of vector dimensions doesn't match!");
+
+    search_config_t config;
+    config.exact = exact;
+
+    py::array_t<label_t> labels_py;
+    py::array_t<distance_t> distances_py;
+    std::size_t count{};
+    auto dump = [&](dense_search_result_t result) {
+        result.error.raise();
+        count = result.size();
+        labels_py.resize(py_shape_t{static_cast<Py_ssize_t>(count)});
+        distances_py.resize(py_shape_t{static_cast<Py_ssize_t>(count)});
+        auto labels_py1d = labels_py.template mutable_unchecked<1>();
+        auto distances_py1d = distances_py.template mutable_unchecked<1>();
+        if (count)
+            result.dump_to(&labels_py1d(0), &distances_py1d(0));
+    };
+
+    switch (numpy_string_to_kind(vector_info.format)) {
+    case scalar_kind_t::b1x8_k: dump(index.search_range((b1x8_t const*)(vector_data), radius, config)); break;
+    case scalar_kind_t::f8_k: dump(index.search_range((f8_bits_t const*)(vector_data), radius, config)); break;
+    case scalar_kind_t::f16_k: dump(index.search_range((f16_t const*)(vector_data), radius, config)); break;
+    case scalar_kind_t::f32_k: dump(index.search_range((f32_t const*)(vector_data), radius, config)); break;
+    case scalar_kind_t::f64_k: dump(index.search_range((f64_t const*)(vector_data), radius, config)); break;
+    case scalar_kind_t::unknown_k:
+        throw std::invalid_argument("Incompatible scalars in the query vector: " + vector_info.format);
+    }
+
+    py::tuple results(3);
+    results[0] = labels_py;
+    results[1] = distances_py;
+    results[2] = static_cast<Py_ssize_t>(count);
+    return results;
+}
+
+template <typename scalar_at>
+static void search_range_typed(                          //
+    dense_index_py_t& index, py::buffer_info& vectors_info, //
+    distance_t radius, bool exact, std::size_t threads,     //
+    std::vector<std::vector<label_t>>& labels, std::vector<std::vector<distance_t>>& distances) {
+
+    Py_ssize_t vectors_count = vectors_info.shape[0];
+    char const* vectors_data = reinterpret_cast<char const*>(vectors_info.ptr);
+
+    if (!threads)
+        threads = std::thread::hardware_concurrency();
+    if (!index.reserve(index_limits_t(index.size(), threads)))
+        throw std::invalid_argument("Out of memory!");
+
+    executor_default_t{threads}.execute_bulk(vectors_count, [&](std::size_t thread_idx, std::size_t task_idx) {
+        search_config_t config;
+        config.thread = thread_idx;
+        config.exact = exact;
+        scalar_at const* vector = (scalar_at const*)(vectors_data + task_idx * vectors_info.strides[0]);
+        dense_search_result_t result = index.search_range(vector, radius, config);
+        result.error.raise();
+        labels[task_idx].resize(result.size());
+        distances[task_idx].resize(result.size());
+        result.dump_to(labels[task_idx].data(), distances[task_idx].data());
+        if (PyErr_CheckSignals() != 0)
+            throw py::error_already_set();
+    });
+}
+
+/**
+ *  @param vectors Matrix of vectors to search for.
+ *  @param radius Upper bound for the distance of matches.
+ *
+ *  @return Tuple with:
+ *      1. matrix of neighbors, as wide as the longest list of matches,
+ *      2. matrix of distances,
+ *      3. array with match counts.
+ */
+static py::tuple search_range_many_in_index( //
+    dense_index_py_t& index, py::buffer vectors, distance_t radius, bool exact, std::size_t threads) {
+
+    if (index.limits().threads_search < threads)
+        throw std::invalid_argument("Can't use that many threads!");
+
+    py::buffer_info vectors_info = vectors.request();
+    if (vectors_info.ndim == 1)
+        return search_range_one_in_index(index, vectors, radius, exact);
+    if (vectors_info.ndim != 2)
+        throw std::invalid_argument("Expects a matrix of vectors to add!");
+
+    Py_ssize_t vectors_count = vectors_info.shape[0];
+    Py_ssize_t vectors_dimensions = vectors_info.shape[1];
+    if (vectors_dimensions != static_cast<Py_ssize_t>(index.scalar_words()))
+        throw std::invalid_argument("The number of vector dimensions doesn't match!");
+
+    // The number of matches isn't known in advance, so they are collected first.
+    std::vector<std::vector<label_t>> ls(vectors_count);
+    std::vector<std::vector<distance_t>> ds(vectors_count);
+    switch (numpy_string_to_kind(vectors_info.format)) {
+    case scalar_kind_t::b1x8_k: search_range_typed<b1x8_t>(index, vectors_info, radius, exact, threads, ls, ds); break;
+    case scalar_kind_t::f8_k: search_range_typed<f8_bits_t>(index, vectors_info, radius, exact, threads, ls, ds); break;
+    case scalar_kind_t::f16_k: search_range_typed<f16_t>(index, vectors_info, radius, exact, threads, ls, ds); break;
+    case scalar_kind_t::f32_k: search_range_typed<f32_t>(index, vectors_info, radius, exact, threads, ls, ds); break;
+    case scalar_kind_t::f64_k: search_range_typed<f64_t>(index, vectors_info, radius, exact, threads, ls, ds); break;
+    case scalar_kind_t::unknown_k:
+        throw std::invalid_argument("Incompatible scalars in the query matrix: " + vectors_info.format);
+    }
+
+    std::size_t widest = 0;
+    for (auto const& row : ls)
+        widest = (std::max)(widest, row.size());
+
+    py::array_t<label_t> ls_py({vectors_count, static_cast<Py_ssize_t>(widest)});
+    py::array_t<distance_t> ds_py({vectors_count, static_cast<Py_ssize_t>(widest)});
+    py::array_t<Py_ssize_t> cs_py(vectors_count);
+    auto labels_py2d = ls_py.template mutable_unchecked<2>();
+    auto distances_py2d = ds_py.template mutable_unchecked<2>();
+    auto counts_py1d = cs_py.template mutable_unchecked<1>();
+    for (Py_ssize_t row = 0; row != vectors_count; ++row) {
+        std::size_t count = ls[row].size();
+        counts_py1d(row) = static_cast<Py_ssize_t>(count);
+        for (std::size_t col = 0; col != widest; ++col) {
+            labels_py2d(row, col) = col < count ? ls[row][col] : label_t{};
+            distances_py2d(row, col) = col < count ? ds[row][col] : distance_t{};
+        }
+    }
+
+    py::tuple results(3);
+    results[0] = ls_py;
+    results[1] = ds_py;
+    results[2] = cs_py;
+    return results;
+}
+
 static std::unordered_map<label_t, label_t> join_index(   //
     dense_index_py_t const& a, dense_index_py_t const& b, //
     std::size_t max_proposals, bool exact) {
@@ -631,6 +809,7 @@ PYBIND11_MODULE(compiled, m) {
     h.def_readonly("bytes_for_graphs", &file_head_result_t::bytes_for_graphs);
     h.def_readonly("bytes_for_vectors", &file_head_result_t::bytes_for_vectors);
     h.def_readonly("bytes_checksum", &file_head_result_t::bytes_checksum);
+    h.def_readonly("flags", &file_head_result_t::flags);
 
     auto i = py::class_<dense_index_py_t>(m, "Index");
 
@@ -673,6 +852,14 @@ PYBIND11_MODULE(compiled, m) {
         py::arg("threads") = 0           //
     );
 
+    i.def(                                           //
+        "search_range", &search_range_many_in_index, //
+        py::arg("query"),                            //
+        py::arg("radius"),                           //
+        py::arg("exact") = false,                    //
+        py::arg("threads") = 0                       //
+    );
+
     i.def(
         "rename",
         [](dense_index_py_t& index, label_t from, label_t to) -> bool {
@@ -719,6 +906,31 @@ PYBIND11_MODULE(compiled, m) {
         },
         py::arg("label"), py::arg("compact"), py::arg("threads"));
 
+    i.def(
+        "refine",
+        [](dense_index_py_t& index, std::size_t threads) -> std::size_t {
+            if (!threads)
+                threads = std::thread::hardware_concurrency();
+            if (!index.reserve(index_limits_t(index.capacity(), threads)))
+                throw std::invalid_argument("Out of memory!");
+
+            auto result = index.refine_graph(executor_default_t{threads});
+            result.error.raise();
+            return result.replaced_edges;
+        },
+        py::arg("threads") = 0, py::call_guard<py::gil_scoped_release>());
+
+    i.def(
+        "reorder",
+        [](dense_index_py_t& index, std::size_t threads) -> std::size_t {
+            if (!threads)
+                threads = std::thread::hardware_concurrency();
+            auto result = index.reorder(executor_default_t{threads});
+            result.error.raise();
+            return result.reachable;
+        },
+        py::arg("threads") = 0, py::call_guard<py::gil_scoped_release>());
+
     i.def("__len__", &dense_index_py_t::size);
     i.def_property_readonly("size", &dense_index_py_t::size);
     i.def_property_readonly("ndim", &dense_index_py_t::dimensions);
@@ -753,6 +965,8 @@ PYBIND11_MODULE(compiled, m) {
     i_stats.def_readonly("edges", &punned_index_stats_t::edges);
     i_stats.def_readonly("max_edges", &punned_index_stats_t::max_edges);
     i_stats.def_readonly("allocated_bytes", &punned_index_stats_t::allocated_bytes);
+    i_stats.def_readonly("lock_acquisitions", &punned_index_stats_t::lock_acquisitions);
+    i_stats.def_readonly("lock_spins", &punned_index_stats_t::lock_spins);
 
     i.def_property_readonly("max_level", &max_level<dense_index_py_t>);
     i.def_property_readonly("levels_stats", &compute_stats<dense_index_py_t>);
@@ -401,9 +401,12 @@ class Index:
         exact: bool = False,
         log: Union[str, bool] = False,
         batch_size: int = 0,
+        radius: Optional[float] = None,
     ) -> Matches:
         """
         Performs approximate nearest neighbors search for one or more queries.
+        With `radius` set, returns all found neighbors within that distance,
+        ignoring `k` and padding the rows to the longest list of matches.
 
         :param vectors: Query vector or vectors.
         :type vectors: Buffer
@@ -417,6 +420,8 @@ class Index:
         :type log: Union[str, bool], optional
         :param batch_size: Number of vectors to process at once, defaults to 0
         :type batch_size: int, optional
+        :param radius: Upper bound for the distance of matches, defaults to None
+        :type radius: Optional[float], optional
         :return: Approximate matches for one or more queries
         :rtype: Matches
         """
@@ -425,6 +430,23 @@ class Index:
         assert vectors.ndim == 1 or vectors.ndim == 2, "Expects a matrix or vector"
         count_vectors = vectors.shape[0] if vectors.ndim == 2 else 1
 
+        def search_chunk(vectors) -> Matches:
+            if radius is not None:
+                tuple_ = self._compiled.search_range(
+                    vectors,
+                    radius,
+                    exact=exact,
+                    threads=threads,
+                )
+            else:
+                tuple_ = self._compiled.search(
+                    vectors,
+                    k,
+                    exact=exact,
+                    threads=threads,
+                )
+            return Matches(*tuple_)
+
         if log and batch_size == 0:
             batch_size = int(math.ceil(count_vectors / 100))
 
@@ -443,30 +465,25 @@ class Index:
                 disable=log is False,
             )
             for vectors in tasks:
-                tuple_ = self._compiled.search(
-                    vectors,
-                    k,
-                    exact=exact,
-                    threads=threads,
-                )
-                tasks_matches.append(Matches(*tuple_))
+                tasks_matches.append(search_chunk(vectors))
                 pbar.update(vectors.shape[0])
 
             pbar.close()
+
+            # Range queries produce batches of different widths
+            width = max(m.labels.shape[1] for m in tasks_matches)
+
+            def pad(matrix: np.ndarray) -> np.ndarray:
+                return np.pad(matrix, ((0, 0), (0, width - matrix.shape[1])))
+
             return Matches(
-                labels=np.vstack([m.labels for m in tasks_matches]),
-                distances=np.vstack([m.distances for m in tasks_matches]),
+                labels=np.vstack([pad(m.labels) for m in tasks_matches]),
+                distances=np.vstack([pad(m.distances) for m in tasks_matches]),
                 counts=np.concatenate([m.counts for m in tasks_matches], axis=None),
             )
 
         else:
-            tuple_ = self._compiled.search(
-                vectors,
-                k,
-                exact=exact,
-                threads=threads,
-            )
-            return Matches(*tuple_)
+            return search_chunk(vectors)
 
     def remove(
         self,
@@ -577,10 +594,20 @@ class Index:
     def expansion_search(self, v: int):
         self._compiled.expansion_search = v
 
-    def save(self, path: Optional[os.PathLike] = None):
+    def save(self, path: Optional[os.PathLike] = None, reorder: bool = False):
+        """Saves the index to a file.
+
+        :param path: Destination file, defaults to `self.path`
+        :type path: os.PathLike, optional
+        :param reorder: Renumbers the entries in place before saving, so that neighbors
+            are stored close to each other, speeding up the viewed indexes, defaults to False
+        :type reorder: bool, optional
+        """
         path = path if path else self.path
         if path is None:
             raise Exception("Define `path` argument")
+        if reorder:
+            self._compiled.reorder()
         self._compiled.save(path)
 
     def load(self, path: Optional[os.PathLike] = None):
@@ -635,6 +662,31 @@ class Index:
             exact=exact,
         )
 
+    def reorder(self, threads: int = 0) -> int:
+        """Renumbers the entries in the Breadth-First order of the graph, so that
+        neighbors are stored close to each other in memory and in saved files.
+        Labels are preserved. Shouldn't overlap with any other operation.
+
+        :param threads: Optimal number of cores to use, defaults to 0
+        :type threads: int, optional
+        :return: Number of entries reachable from the entry point
+        :rtype: int
+        """
+        return self._compiled.reorder(threads=threads)
+
+    def refine(self, threads: int = 0) -> int:
+        """Improves the links of an already constructed graph, re-selecting the
+        neighbors of every node among the neighbors of its neighbors. Helps to
+        recover recall after a fast construction with a low `expansion_add`.
+        Shouldn't overlap with concurrent insertions.
+
+        :param threads: Optimal number of cores to use, defaults to 0
+        :type threads: int, optional
+        :return: Number of replaced edges
+        :rtype: int
+        """
+        return self._compiled.refine(threads=threads)
+
     def get_labels(self, offset: int = 0, limit: int = 0) -> np.ndarray:
         if limit == 0:
             limit = 2**63 - 1